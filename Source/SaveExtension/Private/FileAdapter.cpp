@@ -8,6 +8,9 @@
 #include <Serialization/MemoryWriter.h>
 #include <Serialization/ArchiveSaveCompressedProxy.h>
 #include <Serialization/ArchiveLoadCompressedProxy.h>
+#include <HAL/FileManager.h>
+#include <HAL/PlatformFileManager.h>
+#include <Templates/UniquePtr.h>
 #include <SaveGameSystem.h>
 
 #include "SavePreset.h"
@@ -18,6 +21,56 @@
 
 static const int SE_SAVEGAME_FILE_TYPE_TAG = 0x0001;		// "sAvG"
 
+/** Bytes read at once when only the header of a file is needed. Headers fit unless they embed a thumbnail */
+static constexpr int64 HeaderPrefixSize = 8 * 1024;
+
+/** Recently read files. Least recently used are discarded first */
+namespace FileCache
+{
+	struct FEntry
+	{
+		FString SlotName;
+		TSharedPtr<const FSaveFile> File;
+		int64 Size = 0;
+		bool bHasData = false;
+	};
+
+	static FCriticalSection Lock;
+	// Most recently used last
+	static TArray<FEntry> Entries;
+	static int64 UsedBytes = 0;
+	static int64 BudgetBytes = 0;
+	// Increased every time a file is written or deleted
+	static uint64 Generation = 0;
+
+	static int64 GetSize(const FSaveFile& File)
+	{
+		return sizeof(FSaveFile) + File.ThumbnailBytes.Num() + File.InfoBytes.Num() + File.DataBytes.Num() + File.RecordBytes.Num()
+			+ File.References.Num() * sizeof(FSoftObjectPath);
+	}
+
+	static int32 Find(FStringView SlotName)
+	{
+		return Entries.IndexOfByPredicate([SlotName](const FEntry& Entry) {
+			return SlotName.Equals(Entry.SlotName, ESearchCase::IgnoreCase);
+		});
+	}
+
+	static void Remove(int32 Index)
+	{
+		UsedBytes -= Entries[Index].Size;
+		Entries.RemoveAt(Index);
+	}
+
+	static void Trim()
+	{
+		while (UsedBytes > BudgetBytes && Entries.Num() > 0)
+		{
+			Remove(0);
+		}
+	}
+}
+
 struct FSaveGameFileVersion
 {
 	enum Type
@@ -25,6 +78,20 @@ struct FSaveGameFileVersion
 		InitialVersion = 1,
 		// serializing custom versions into the savegame data to handle that type of versioning
 		AddedCustomVersions = 2,
+		// list of classes and assets referenced by the data, after the info
+		AddedReferences = 3,
+		// save date of the info, after the header information
+		AddedSaveDate = 4,
+		// summary of the info, replacing the save date
+		AddedSummary = 5,
+		// records of the data serialized apart from its properties, after the data bytes
+		AddedRecordBytes = 6,
+		// compressed thumbnail, after the summary
+		AddedThumbnail = 7,
+		// records saved as a sequence of chunks by FSaveFileStream
+		AddedRecordChunks = 8,
+		// sub-level records encoded apart, so they are only decoded when needed
+		AddedLazySubLevels = 9,
 
 		// -----<new versions can be added above this line>-------------------------------------------------
 		VersionPlusOne,
@@ -76,12 +143,36 @@ bool FSaveFile::IsEmpty() const
 	return FileTypeTag == 0;
 }
 
+bool FSaveFile::HasSummary() const
+{
+	return SaveGameFileVersion >= FSaveGameFileVersion::AddedSummary;
+}
+
+bool FSaveFile::HasRecordBytes() const
+{
+	return SaveGameFileVersion >= FSaveGameFileVersion::AddedRecordBytes;
+}
+
+bool FSaveFile::HasLazySubLevels() const
+{
+	return SaveGameFileVersion >= FSaveGameFileVersion::AddedLazySubLevels;
+}
+
 void FSaveFile::Read(FScopedFileReader& Reader, bool bSkipData)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::Read);
 
+	if (ReadHeader(Reader) && !bSkipData)
+	{
+		ReadData(Reader);
+	}
+}
+
+bool FSaveFile::ReadHeader(FArchive& Ar)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::ReadHeader);
+
 	Empty();
-	FArchive& Ar = Reader.GetArchive();
 
 	{ // Header information
 		Ar << FileTypeTag;
@@ -90,7 +181,7 @@ void FSaveFile::Read(FScopedFileReader& Reader, bool bSkipData)
 			// this is an old saved game, back up the file pointer to the beginning and assume version 1
 			Ar.Seek(0);
 			SaveGameFileVersion = FSaveGameFileVersion::InitialVersion;
-			return;
+			return false;
 		}
 
 		// Read version for this file format
@@ -107,19 +198,60 @@ void FSaveFile::Read(FScopedFileReader& Reader, bool bSkipData)
 			CustomVersions.Serialize(Ar, static_cast<ECustomVersionSerializationFormat::Type>(CustomVersionFormat));
 			Ar.SetCustomVersions(CustomVersions);
 		}
+
+		if (SaveGameFileVersion >= FSaveGameFileVersion::AddedSummary)
+		{
+			Ar << Summary;
+		}
+		else if (SaveGameFileVersion >= FSaveGameFileVersion::AddedSaveDate)
+		{
+			Ar << Summary.SaveDate;
+		}
+
+		if (SaveGameFileVersion >= FSaveGameFileVersion::AddedThumbnail)
+		{
+			int32 NumThumbnailBytes = 0;
+			Ar << NumThumbnailBytes;
+			// Known before reading it, so that partial reads can tell how much of the file they need
+			ThumbnailEnd = Ar.Tell() + NumThumbnailBytes;
+			if (NumThumbnailBytes < 0 || ThumbnailEnd > Ar.TotalSize())
+			{
+				Ar.SetError();
+				return false;
+			}
+			ThumbnailBytes.SetNumUninitialized(NumThumbnailBytes);
+			Ar.Serialize(ThumbnailBytes.GetData(), NumThumbnailBytes);
+		}
 	}
 
 	Ar << InfoClassName;
 	Ar << InfoBytes;
 
-	Ar << DataClassName;
-	if(bSkipData || DataClassName.IsEmpty())
+	if (SaveGameFileVersion >= FSaveGameFileVersion::AddedReferences)
 	{
-		return;
+		SerializeReferences(Ar, References);
 	}
 
+	Ar << DataClassName;
+	return !DataClassName.IsEmpty();
+}
+
+void FSaveFile::ReadData(FScopedFileReader& Reader)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::ReadData);
+
+	FArchive& Ar = Reader.GetArchive();
 	Ar << bIsDataCompressed;
-	if(bIsDataCompressed)
+	if (SaveGameFileVersion >= FSaveGameFileVersion::AddedRecordChunks)
+	{
+		Ar << bRecordsChunked;
+	}
+
+	if (bRecordsChunked)
+	{
+		ReadRecordChunks(Ar);
+	}
+	else if(bIsDataCompressed)
 	{
 		TArray<uint8> CompressedDataBytes;
 		Ar << CompressedDataBytes;
@@ -129,6 +261,10 @@ void FSaveFile::Read(FScopedFileReader& Reader, bool bSkipData)
 		if (!Decompressor.GetError())
 		{
 			Decompressor << DataBytes;
+			if (HasRecordBytes())
+			{
+				Decompressor << RecordBytes;
+			}
 			Decompressor.Close();
 		}
 		else
@@ -139,16 +275,94 @@ void FSaveFile::Read(FScopedFileReader& Reader, bool bSkipData)
 	else
 	{
 		Ar << DataBytes;
+		if (HasRecordBytes())
+		{
+			Ar << RecordBytes;
+		}
 	}
 }
 
-void FSaveFile::Write(FScopedFileWriter& Writer, bool bCompressData)
+void FSaveFile::ReadRecordChunks(FArchive& Ar)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::Write);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::ReadRecordChunks);
 
-	bIsDataCompressed = bCompressData;
-	FArchive& Ar = Writer.GetArchive();
+	ReadChunkPayload(Ar, DataBytes, bIsDataCompressed);
+
+	// Chunks are kept decompressed, in order, with the size of their payload. See DecodeRecordChunks
+	RecordBytes.Reset();
+	FMemoryWriter Writer{ RecordBytes };
+	TArray<uint8> Payload;
+	while (!Ar.IsError() && !Ar.AtEnd())
+	{
+		uint8 Type = 0;
+		Ar << Type;
+		Writer << Type;
+		if (Type == uint8(ESERecordChunk::End))
+		{
+			break;
+		}
+
+		int32 LevelIndex = INDEX_NONE;
+		Ar << LevelIndex;
+		Writer << LevelIndex;
+
+		ReadChunkPayload(Ar, Payload, bIsDataCompressed);
+		Writer << Payload;
+	}
+
+	if (Ar.IsError())
+	{
+		UE_LOG(LogSaveExtension, Warning, TEXT("Failed to read record chunks"));
+	}
+}
+
+void FSaveFile::WriteChunkPayload(FArchive& Ar, TArray<uint8>& Bytes, bool bCompressed)
+{
+	if (bCompressed)
+	{
+		TArray<uint8> CompressedBytes;
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(Compression);
+			FArchiveSaveCompressedProxy Compressor(CompressedBytes, NAME_Zlib);
+			Compressor << Bytes;
+			Compressor.Close();
+		}
+		Ar << CompressedBytes;
+	}
+	else
+	{
+		Ar << Bytes;
+	}
+}
+
+void FSaveFile::ReadChunkPayload(FArchive& Ar, TArray<uint8>& OutBytes, bool bCompressed)
+{
+	if (bCompressed)
+	{
+		TArray<uint8> CompressedBytes;
+		Ar << CompressedBytes;
+
+		TRACE_CPUPROFILER_EVENT_SCOPE(Decompression);
+		FArchiveLoadCompressedProxy Decompressor(CompressedBytes, NAME_Zlib);
+		if (!Decompressor.GetError())
+		{
+			Decompressor << OutBytes;
+			Decompressor.Close();
+		}
+		else
+		{
+			OutBytes.Reset();
+			UE_LOG(LogSaveExtension, Warning, TEXT("Failed to decompress data"));
+		}
+	}
+	else
+	{
+		Ar << OutBytes;
+	}
+}
 
+void FSaveFile::WriteHeader(FArchive& Ar)
+{
 	{ // Header information
 		Ar << FileTypeTag;
 		Ar << SaveGameFileVersion;
@@ -156,15 +370,31 @@ void FSaveFile::Write(FScopedFileWriter& Writer, bool bCompressData)
 		Ar << SavedEngineVersion;
 		Ar << CustomVersionFormat;
 		CustomVersions.Serialize(Ar, static_cast<ECustomVersionSerializationFormat::Type>(CustomVersionFormat));
+		Ar << Summary;
+		Ar << ThumbnailBytes;
 	}
 
 	Ar << InfoClassName;
 	Ar << InfoBytes;
 
+	SerializeReferences(Ar, References);
+
 	Ar << DataClassName;
+}
+
+void FSaveFile::Write(FScopedFileWriter& Writer, bool bCompressData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::Write);
+
+	bIsDataCompressed = bCompressData;
+	bRecordsChunked = false;
+	FArchive& Ar = Writer.GetArchive();
+
+	WriteHeader(Ar);
 	if(!DataClassName.IsEmpty())
 	{
 		Ar << bIsDataCompressed;
+		Ar << bRecordsChunked;
 		if(bIsDataCompressed)
 		{
 			TArray<uint8> CompressedDataBytes;
@@ -173,6 +403,7 @@ void FSaveFile::Write(FScopedFileWriter& Writer, bool bCompressData)
 				// Compress Object data
 				FArchiveSaveCompressedProxy Compressor(CompressedDataBytes, NAME_Zlib);
 				Compressor << DataBytes;
+				Compressor << RecordBytes;
 				Compressor.Close();
 			}
 			Ar << CompressedDataBytes;
@@ -180,32 +411,270 @@ void FSaveFile::Write(FScopedFileWriter& Writer, bool bCompressData)
 		else
 		{
 			Ar << DataBytes;
+			Ar << RecordBytes;
 		}
 	}
 	Ar.Close();
 }
 
+void FSaveFile::WriteStreamed(FArchive& Ar, FArchive& Chunks, bool bCompressData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::WriteStreamed);
+	check(!DataClassName.IsEmpty());
+
+	bIsDataCompressed = bCompressData;
+	bRecordsChunked = true;
+
+	WriteHeader(Ar);
+	Ar << bIsDataCompressed;
+	Ar << bRecordsChunked;
+	WriteChunkPayload(Ar, DataBytes, bIsDataCompressed);
+
+	// Chunks were already compressed. They are copied in small blocks
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(256 * 1024);
+	int64 Remaining = Chunks.TotalSize() - Chunks.Tell();
+	while (Remaining > 0 && !Chunks.IsError())
+	{
+		const int32 Size = int32(FMath::Min<int64>(Remaining, Buffer.Num()));
+		Chunks.Serialize(Buffer.GetData(), Size);
+		Ar.Serialize(Buffer.GetData(), Size);
+		Remaining -= Size;
+	}
+	if (Chunks.IsError())
+	{
+		Ar.SetError();
+	}
+	Ar.Close();
+}
+
 void FSaveFile::SerializeInfo(USlotInfo* SlotInfo)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::SerializeInfo);
 	check(SlotInfo);
 	InfoBytes.Reset();
 	InfoClassName = SlotInfo->GetClass()->GetPathName();
+	Summary = FSlotSummary{ *SlotInfo };
+	ThumbnailBytes = SlotInfo->GetEmbeddedThumbnail();
 
 	FMemoryWriter BytesWriter(InfoBytes);
 	FObjectAndNameAsStringProxyArchive Ar(BytesWriter, false);
 	SlotInfo->Serialize(Ar);
 }
-void FSaveFile::SerializeData(USlotData* SlotData)
+void FSaveFile::SerializeData(USlotData* SlotData, bool bWithRecords)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::SerializeData);
 	check(SlotData);
 	DataBytes.Reset();
+	RecordBytes.Reset();
 	DataClassName = SlotData->GetClass()->GetPathName();
+	{
+		FMemoryWriter BytesWriter(DataBytes);
+		FObjectAndNameAsStringProxyArchive Ar(BytesWriter, false);
+		SlotData->SerializeProperties(Ar);
+	}
+	if (bWithRecords)
+	{
+		FMemoryWriter BytesWriter(RecordBytes);
+		FObjectAndNameAsStringProxyArchive Ar(BytesWriter, false);
+		SlotData->SerializeRecords(Ar);
+	}
 
-	FMemoryWriter BytesWriter(DataBytes);
-	FObjectAndNameAsStringProxyArchive Ar(BytesWriter, false);
-	SlotData->Serialize(Ar);
+	CollectReferences(SlotData);
+}
+
+void FSaveFile::CollectReferences(const USlotData* SlotData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::CollectReferences);
+
+	TSet<const UClass*> Classes;
+	TSet<FSoftObjectPath> Assets;
+	const auto AddLevel = [&Classes, &Assets](const FLevelRecord& Level)
+	{
+		Classes.Add(Level.LevelScript.Class);
+		for (const FActorRecord& Actor : Level.Actors)
+		{
+			Classes.Add(Actor.Class);
+			for (const FComponentRecord& Component : Actor.ComponentRecords)
+			{
+				Classes.Add(Component.Class);
+			}
+		}
+		Assets.Append(Level.AssetReferences);
+	};
+
+	Classes.Add(SlotData->GameInstance.Class);
+	AddLevel(SlotData->MainLevel);
+	for (const FStreamingLevelRecord& Level : SlotData->SubLevels)
+	{
+		AddLevel(Level);
+	}
+
+	for (const UClass* Class : Classes)
+	{
+		// Native classes are always loaded
+		if (Class && !Class->HasAnyClassFlags(CLASS_Native))
+		{
+			Assets.Add(FSoftObjectPath{ Class });
+		}
+	}
+	References = Assets.Array();
+}
+
+void FSaveFile::SerializeReferences(FArchive& Ar, TArray<FSoftObjectPath>& InReferences)
+{
+	// Serialized as plain paths, this archive doesn't resolve soft objects
+	int32 Num = InReferences.Num();
+	Ar << Num;
+	if (Ar.IsLoading())
+	{
+		if (Num < 0)
+		{
+			Ar.SetError();
+			return;
+		}
+		InReferences.SetNum(Num);
+	}
+
+	FString Path;
+	for (FSoftObjectPath& Reference : InReferences)
+	{
+		if (Ar.IsLoading())
+		{
+			Ar << Path;
+			Reference.SetPath(Path);
+		}
+		else
+		{
+			Path = Reference.ToString();
+			Ar << Path;
+		}
+	}
+}
+
+/**
+ * Rebuilds records from the chunks of a streamed file, in the order they were written.
+ * Sub-levels without streamed actors are kept encoded until needed, like FStreamingLevelRecord::SerializeLazy does
+ * @return false if the chunks are corrupted. Records are left empty
+ */
+static bool DecodeRecordChunks(const TArray<uint8>& Bytes, FSlotDataRecords& Records)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(DecodeRecordChunks);
+
+	Records.MainLevel.CleanRecords();
+	Records.SubLevels.Reset();
+	const auto Fail = [&Records](const TCHAR* Reason) {
+		UE_LOG(LogSaveExtension, Warning, TEXT("Failed to decode record chunks: %s"), Reason);
+		Records.MainLevel.CleanRecords();
+		Records.SubLevels.Reset();
+		return false;
+	};
+
+	struct FChunk
+	{
+		ESERecordChunk Type = ESERecordChunk::End;
+		int32 LevelIndex = INDEX_NONE;
+		int64 Offset = 0;
+		int32 Size = 0;
+	};
+
+	// Headers are read first. Every sub-level is written as a Level chunk, so they bound the indices of all chunks
+	TArray<FChunk> Chunks;
+	int32 NumSubLevels = 0;
+	{
+		FMemoryReader Reader{ Bytes };
+		while (!Reader.AtEnd())
+		{
+			uint8 Type = 0;
+			Reader << Type;
+			if (Type == uint8(ESERecordChunk::End))
+			{
+				break;
+			}
+
+			FChunk& Chunk = Chunks.AddDefaulted_GetRef();
+			Chunk.Type = ESERecordChunk(Type);
+			Reader << Chunk.LevelIndex;
+			Reader << Chunk.Size;
+			Chunk.Offset = Reader.Tell();
+			if (Reader.IsError() || Chunk.Size < 0 || Chunk.Offset + Chunk.Size > Bytes.Num())
+			{
+				return Fail(TEXT("invalid chunk size"));
+			}
+			Reader.Seek(Chunk.Offset + Chunk.Size);
+
+			if (Chunk.Type == ESERecordChunk::Level && Chunk.LevelIndex >= 0)
+			{
+				++NumSubLevels;
+			}
+		}
+	}
+
+	TArray<bool> StreamedLevels;
+	StreamedLevels.Init(false, NumSubLevels);
+	for (const FChunk& Chunk : Chunks)
+	{
+		if (Chunk.LevelIndex < INDEX_NONE || Chunk.LevelIndex >= NumSubLevels)
+		{
+			return Fail(TEXT("invalid level index"));
+		}
+		if (Chunk.Type == ESERecordChunk::Actors && Chunk.LevelIndex != INDEX_NONE)
+		{
+			StreamedLevels[Chunk.LevelIndex] = true;
+		}
+	}
+	Records.SubLevels.SetNum(NumSubLevels);
+
+	FMemoryReader Reader{ Bytes };
+	FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+	for (const FChunk& Chunk : Chunks)
+	{
+		Reader.Seek(Chunk.Offset);
+		FLevelRecord& Level = Chunk.LevelIndex == INDEX_NONE
+			? static_cast<FLevelRecord&>(Records.MainLevel)
+			: static_cast<FLevelRecord&>(Records.SubLevels[Chunk.LevelIndex]);
+		switch (Chunk.Type)
+		{
+		case ESERecordChunk::Actors:
+		{
+			TArray<FActorRecord> Actors;
+			Ar << Actors;
+			Level.Actors.Append(MoveTemp(Actors));
+			break;
+		}
+		case ESERecordChunk::Level:
+		{
+			if (Chunk.LevelIndex != INDEX_NONE && !StreamedLevels[Chunk.LevelIndex])
+			{
+				// Written in the format of encoded levels. Kept as is
+				TArray<uint8> Encoded{ Bytes.GetData() + Chunk.Offset, Chunk.Size };
+				if (!Records.SubLevels[Chunk.LevelIndex].SetEncoded(MoveTemp(Encoded)))
+				{
+					return Fail(TEXT("invalid level chunk"));
+				}
+				Reader.Seek(Chunk.Offset + Chunk.Size);
+				break;
+			}
+
+			// Actors streamed before the level are kept
+			TArray<FActorRecord> StreamedActors = MoveTemp(Level.Actors);
+			Level.Serialize(Ar);
+			Level.Actors.Append(MoveTemp(StreamedActors));
+			break;
+		}
+		case ESERecordChunk::Globals:
+			Records.SerializeGlobals(Ar);
+			break;
+		default:
+			return Fail(TEXT("unknown chunk type"));
+		}
+
+		if (Ar.IsError() || Reader.Tell() != Chunk.Offset + Chunk.Size)
+		{
+			return Fail(TEXT("chunk doesn't match its size"));
+		}
+	}
+	return true;
 }
 
 USlotInfo* FSaveFile::CreateAndDeserializeInfo(const UObject* Outer) const
@@ -213,15 +682,247 @@ USlotInfo* FSaveFile::CreateAndDeserializeInfo(const UObject* Outer) const
 	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::CreateAndDeserializeInfo);
 	UObject* Object = nullptr;
 	FFileAdapter::DeserializeObject(Object, InfoClassName, Outer, InfoBytes);
-	return Cast<USlotInfo>(Object);
+	USlotInfo* Info = Cast<USlotInfo>(Object);
+	if (Info && ThumbnailBytes.Num() > 0)
+	{
+		Info->_SetEmbeddedThumbnail(ThumbnailBytes);
+	}
+	return Info;
 }
 
-USlotData* FSaveFile::CreateAndDeserializeData(const UObject* Outer) const
+USlotData* FSaveFile::CreateAndDeserializeData(const UObject* Outer, FSlotDataRecords* Records) const
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::CreateAndDeserializeData);
-	UObject* Object = nullptr;
-	FFileAdapter::DeserializeObject(Object, DataClassName, Outer, DataBytes);
-	return Cast<USlotData>(Object);
+	if (!HasRecordBytes())
+	{
+		UObject* Object = nullptr;
+		FFileAdapter::DeserializeObject(Object, DataClassName, Outer, DataBytes);
+		return Cast<USlotData>(Object);
+	}
+
+	UClass* DataClass = FFileAdapter::FindObjectClass(DataClassName);
+	if (!DataClass || !DataClass->IsChildOf<USlotData>())
+	{
+		return nullptr;
+	}
+
+	USlotData* Data = NewObject<USlotData>(Outer ? const_cast<UObject*>(Outer) : GetTransientPackage(), DataClass);
+	return DeserializeData(Data, Records) ? Data : nullptr;
+}
+
+bool FSaveFile::DeserializeData(USlotData* Data, FSlotDataRecords* Records) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::DeserializeData);
+	if (!Data || DataBytes.Num() <= 0 || Data->GetClass()->GetPathName() != DataClassName)
+	{
+		return false;
+	}
+
+	if (!HasRecordBytes())
+	{
+		UObject* Object = Data;
+		FFileAdapter::DeserializeObject(Object, DataClassName, nullptr, DataBytes);
+		return true;
+	}
+
+	// Decoded before modifying the data, so that corrupted chunks leave it untouched
+	FSlotDataRecords Decoded;
+	if (!Records && bRecordsChunked)
+	{
+		if (!DecodeRecordChunks(RecordBytes, Decoded))
+		{
+			return false;
+		}
+		Records = &Decoded;
+	}
+
+	{
+		FMemoryReader Reader{ DataBytes };
+		FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+		Data->SerializeProperties(Ar);
+	}
+
+	if (Records)
+	{
+		// Decoded records are swapped in. Their previous memory is released with Records
+		Data->SwapRecords(*Records);
+	}
+	else
+	{
+		FMemoryReader Reader{ RecordBytes };
+		FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+		Data->SerializeRecords(Ar, HasLazySubLevels());
+	}
+	return true;
+}
+
+bool FSaveFile::DeserializeRecords(FSlotDataRecords& OutRecords) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFile::DeserializeRecords);
+	if (!HasRecordBytes() || RecordBytes.Num() <= 0)
+	{
+		return false;
+	}
+
+	if (bRecordsChunked)
+	{
+		return DecodeRecordChunks(RecordBytes, OutRecords);
+	}
+
+	FMemoryReader Reader{ RecordBytes };
+	FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+	OutRecords.Serialize(Ar, HasLazySubLevels());
+	return true;
+}
+
+
+/*********************
+ * FSaveFileStream
+ */
+
+FSaveFileStream::FSaveFileStream(FStringView InSlotName, bool bInCompress)
+	: SlotName(InSlotName)
+	, ScratchPath(FFileAdapter::GetSlotPath(InSlotName) + TEXT(".records"))
+	, bCompress(bInCompress)
+{
+	Scratch.Reset(IFileManager::Get().CreateFileWriter(*ScratchPath));
+}
+
+FSaveFileStream::~FSaveFileStream()
+{
+	WaitForWrites();
+	Scratch.Reset();
+	IFileManager::Get().Delete(*ScratchPath, false, false, true);
+}
+
+TArray<uint8> FSaveFileStream::EncodeChunk(ESERecordChunk Type, int32 LevelIndex, bool bCompress, TFunctionRef<void(FArchive&)> Serialize)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFileStream::EncodeChunk);
+
+	TArray<uint8> Payload;
+	{
+		FMemoryWriter BytesWriter(Payload);
+		FObjectAndNameAsStringProxyArchive Ar(BytesWriter, false);
+		Serialize(Ar);
+	}
+
+	TArray<uint8> Chunk;
+	FMemoryWriter Ar{ Chunk };
+	uint8 TypeValue = uint8(Type);
+	Ar << TypeValue;
+	Ar << LevelIndex;
+	FSaveFile::WriteChunkPayload(Ar, Payload, bCompress);
+	return Chunk;
+}
+
+FGraphEventRef FSaveFileStream::AppendChunk(TArray<uint8>&& Chunk)
+{
+	if (!Scratch)
+	{
+		return {};
+	}
+
+	FScopeLock ScopeLock(&WriteLock);
+	FGraphEventArray Prerequisites;
+	if (LastWrite)
+	{
+		Prerequisites.Add(LastWrite);
+	}
+	LastWrite = FFunctionGraphTask::CreateAndDispatchWhenReady([this, Chunk = MoveTemp(Chunk)]() mutable {
+		TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFileStream::AppendChunk);
+		Scratch->Serialize(Chunk.GetData(), Chunk.Num());
+	}, TStatId{}, &Prerequisites, ENamedThreads::AnyBackgroundThreadNormalTask);
+	return LastWrite;
+}
+
+void FSaveFileStream::WaitForWrites()
+{
+	FGraphEventRef Write;
+	{
+		FScopeLock ScopeLock(&WriteLock);
+		Write = MoveTemp(LastWrite);
+		LastWrite.SafeRelease();
+	}
+	if (Write)
+	{
+		// Chunks are written in order, so all of them are done after the last one
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(Write);
+	}
+}
+
+bool FSaveFileStream::Finish(USlotInfo* Info, USlotData* Data)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSaveFileStream::Finish);
+	check(Info && Data);
+
+	// Errors of chunks being written are known once they finish
+	WaitForWrites();
+	if (!IsValid())
+	{
+		return false;
+	}
+
+	// Levels keep their own records apart from streamed actors, like sub-levels not loaded while saving
+	AppendChunk(EncodeChunk(ESERecordChunk::Level, INDEX_NONE, bCompress, [Data](FArchive& Ar) {
+		Data->MainLevel.Serialize(Ar);
+	}));
+	for (int32 I = 0; I < Data->SubLevels.Num(); ++I)
+	{
+		AppendChunk(EncodeChunk(ESERecordChunk::Level, I, bCompress, [Data, I](FArchive& Ar) {
+			FStreamingLevelRecord& Level = Data->SubLevels[I];
+			TArray<uint8> Bytes;
+			if (Level.IsEncoded() && Level.ReadEncoded(Bytes))
+			{
+				// Already in the same format. No need to decode it
+				Ar.Serialize(Bytes.GetData(), Bytes.Num());
+			}
+			else
+			{
+				Level.Serialize(Ar);
+			}
+		}));
+	}
+	AppendChunk(EncodeChunk(ESERecordChunk::Globals, INDEX_NONE, bCompress, [Data](FArchive& Ar) {
+		Data->SerializeGlobals(Ar);
+	}));
+	WaitForWrites();
+	uint8 End = uint8(ESERecordChunk::End);
+	*Scratch << End;
+
+	const bool bScratchWritten = Scratch->Close() && !Scratch->IsError();
+	Scratch.Reset();
+	if (!bScratchWritten)
+	{
+		return false;
+	}
+
+	FSaveFile File{};
+	File.SerializeInfo(Info);
+	File.SerializeData(Data, false);
+
+	// Written apart and then moved, so that the previous file is only replaced if saving succeeds
+	FFileAdapter::UncacheFile(SlotName);
+	const FString Path = FFileAdapter::GetSlotPath(SlotName);
+	const FString TempPath = Path + TEXT(".tmp");
+	{
+		FScopedFileReader Chunks(ScratchPath);
+		FScopedFileWriter Writer(TempPath);
+		if (!Chunks.IsValid() || !Writer.IsValid())
+		{
+			return false;
+		}
+		File.WriteStreamed(Writer.GetArchive(), Chunks.GetArchive(), bCompress);
+		if (Writer.IsError())
+		{
+			IFileManager::Get().Delete(*TempPath, false, false, true);
+			return false;
+		}
+	}
+	const bool bMoved = IFileManager::Get().Move(*Path, *TempPath, true, true);
+
+	// The previous file may have been cached again while this one was written
+	FFileAdapter::UncacheFile(SlotName);
+	return bMoved;
 }
 
 bool FFileAdapter::SaveFile(FStringView SlotName, USlotInfo* Info, USlotData* Data, const bool bUseCompression)
@@ -239,37 +940,193 @@ bool FFileAdapter::SaveFile(FStringView SlotName, USlotInfo* Info, USlotData* Da
 		return false;
 	}
 
-	FScopedFileWriter FileWriter(GetSlotPath(SlotName));
-	if(FileWriter.IsValid())
+	FSaveFile File{};
+	File.SerializeInfo(Info);
+	File.SerializeData(Data);
+	return SaveFile(SlotName, File, bUseCompression);
+}
+
+bool FFileAdapter::SaveFile(FStringView SlotName, FSaveFile& File, const bool bUseCompression)
+{
+	if (SlotName.IsEmpty())
+	{
+		return false;
+	}
+
+	UncacheFile(SlotName);
+
+	bool bSaved = false;
 	{
-		FSaveFile File{};
-		File.SerializeInfo(Info);
-		File.SerializeData(Data);
-		File.Write(FileWriter, bUseCompression);
-		return !FileWriter.IsError();
+		FScopedFileWriter FileWriter(GetSlotPath(SlotName));
+		if(FileWriter.IsValid())
+		{
+			File.Write(FileWriter, bUseCompression);
+			bSaved = !FileWriter.IsError();
+		}
 	}
-	return false;
+
+	// Readers may have cached the previous or a partially written file meanwhile
+	UncacheFile(SlotName);
+	return bSaved;
 }
 
 bool FFileAdapter::LoadFile(FStringView SlotName, USlotInfo*& Info, USlotData*& Data, bool bLoadData, const UObject* Outer)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FFileAdapter::LoadFile);
 
-	FScopedFileReader Reader(GetSlotPath(SlotName));
-	if(Reader.IsValid())
+	if (TSharedPtr<const FSaveFile> File = ReadFile(SlotName, !bLoadData))
 	{
-		FSaveFile File{};
-		File.Read(Reader, !bLoadData);
-		Info = File.CreateAndDeserializeInfo(Outer);
-		Data = File.CreateAndDeserializeData(Outer);
+		Info = File->CreateAndDeserializeInfo(Outer);
+		Data = File->CreateAndDeserializeData(Outer);
 		return true;
 	}
 	return false;
 }
 
+TSharedPtr<const FSaveFile> FFileAdapter::ReadFile(FStringView SlotName, bool bSkipData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FFileAdapter::ReadFile);
+
+	if (TSharedPtr<const FSaveFile> Cached = FindCachedFile(SlotName, bSkipData))
+	{
+		return Cached;
+	}
+
+	const uint64 Generation = GetFileCacheGeneration();
+	TSharedRef<FSaveFile> File = MakeShared<FSaveFile>();
+	if (!bSkipData || !ReadHeaderPrefix(SlotName, *File))
+	{
+		FScopedFileReader Reader(GetSlotPath(SlotName));
+		if (!Reader.IsValid())
+		{
+			return {};
+		}
+		File->Read(Reader, bSkipData);
+	}
+
+	CacheFile(SlotName, File, !bSkipData || File->DataClassName.IsEmpty(), Generation);
+	return File;
+}
+
+bool FFileAdapter::ReadHeaderPrefix(FStringView SlotName, FSaveFile& File)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FFileAdapter::ReadHeaderPrefix);
+
+	TUniquePtr<IFileHandle> Handle{ FPlatformFileManager::Get().GetPlatformFile().OpenRead(*GetSlotPath(SlotName)) };
+	if (!Handle)
+	{
+		return false;
+	}
+
+	const int64 FileSize = Handle->Size();
+	int64 PrefixSize = FMath::Min(FileSize, HeaderPrefixSize);
+	TArray<uint8> Bytes;
+	while (PrefixSize > Bytes.Num())
+	{
+		// Continues reading after the bytes already read
+		const int64 NumRead = Bytes.Num();
+		Bytes.SetNumUninitialized(PrefixSize);
+		if (!Handle->Read(Bytes.GetData() + NumRead, PrefixSize - NumRead))
+		{
+			return false;
+		}
+
+		// Reading past the prefix sets an error instead of crashing
+		FMemoryReader Reader{ Bytes };
+		File.ReadHeader(Reader);
+		if (!Reader.IsError())
+		{
+			return true;
+		}
+
+		// An embedded thumbnail didn't fit. Its size tells how much more to read
+		PrefixSize = FMath::Min(FileSize, File.ThumbnailEnd + HeaderPrefixSize);
+	}
+	return false;
+}
+
+TSharedPtr<const FSaveFile> FFileAdapter::FindCachedFile(FStringView SlotName, bool bSkipData)
+{
+	FScopeLock ScopeLock(&FileCache::Lock);
+
+	const int32 Index = FileCache::Find(SlotName);
+	if (Index == INDEX_NONE || (!bSkipData && !FileCache::Entries[Index].bHasData))
+	{
+		return {};
+	}
+
+	// Move to the back, as most recently used
+	FileCache::FEntry Entry = MoveTemp(FileCache::Entries[Index]);
+	FileCache::Entries.RemoveAt(Index, 1, false);
+	return FileCache::Entries.Add_GetRef(MoveTemp(Entry)).File;
+}
+
+uint64 FFileAdapter::GetFileCacheGeneration()
+{
+	FScopeLock ScopeLock(&FileCache::Lock);
+	return FileCache::Generation;
+}
+
+void FFileAdapter::CacheFile(FStringView SlotName, const TSharedRef<const FSaveFile>& File, bool bHasData, uint64 ReadGeneration)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FFileAdapter::CacheFile);
+
+	const int64 Size = FileCache::GetSize(*File);
+
+	FScopeLock ScopeLock(&FileCache::Lock);
+	if (Size > FileCache::BudgetBytes || ReadGeneration != FileCache::Generation)
+	{
+		// Files saved while this one was read may have replaced it
+		return;
+	}
+
+	const int32 Index = FileCache::Find(SlotName);
+	if (Index != INDEX_NONE)
+	{
+		if (FileCache::Entries[Index].bHasData && !bHasData)
+		{
+			// Don't replace a complete file with its header
+			return;
+		}
+		FileCache::Remove(Index);
+	}
+
+	FileCache::Entries.Add({ FString{ SlotName }, File, Size, bHasData });
+	FileCache::UsedBytes += Size;
+	FileCache::Trim();
+}
+
+void FFileAdapter::UncacheFile(FStringView SlotName)
+{
+	FScopeLock ScopeLock(&FileCache::Lock);
+	++FileCache::Generation;
+	const int32 Index = FileCache::Find(SlotName);
+	if (Index != INDEX_NONE)
+	{
+		FileCache::Remove(Index);
+	}
+}
+
+void FFileAdapter::ClearFileCache()
+{
+	FScopeLock ScopeLock(&FileCache::Lock);
+	FileCache::Entries.Empty();
+	FileCache::UsedBytes = 0;
+}
+
+void FFileAdapter::SetFileCacheBudget(int64 Bytes)
+{
+	FScopeLock ScopeLock(&FileCache::Lock);
+	FileCache::BudgetBytes = FMath::Max<int64>(Bytes, 0);
+	FileCache::Trim();
+}
+
 bool FFileAdapter::DeleteFile(FStringView SlotName)
 {
-	return IFileManager::Get().Delete(*GetSlotPath(SlotName), true, false, true);
+	UncacheFile(SlotName);
+	const bool bDeleted = IFileManager::Get().Delete(*GetSlotPath(SlotName), true, false, true);
+	UncacheFile(SlotName);
+	return bDeleted;
 }
 
 bool FFileAdapter::DoesFileExist(FStringView SlotName)
@@ -293,6 +1150,16 @@ FString FFileAdapter::GetThumbnailPath(FStringView SlotName)
 	return GetSaveFolder() / FString::Printf(TEXT("%s.png"), SlotName.GetData());
 }
 
+UClass* FFileAdapter::FindObjectClass(FStringView ClassName)
+{
+	UClass* ObjectClass = FindObject<UClass>(ANY_PACKAGE, ClassName.GetData());
+	if (!ObjectClass)
+	{
+		ObjectClass = LoadObject<UClass>(nullptr, ClassName.GetData());
+	}
+	return ObjectClass;
+}
+
 void FFileAdapter::DeserializeObject(UObject*& Object, FStringView ClassName, const UObject* Outer, const TArray<uint8>& Bytes)
 {
 	if (ClassName.IsEmpty() || Bytes.Num() <= 0)
@@ -300,11 +1167,7 @@ void FFileAdapter::DeserializeObject(UObject*& Object, FStringView ClassName, co
 		return;
 	}
 
-	UClass* ObjectClass = FindObject<UClass>(ANY_PACKAGE, ClassName.GetData());
-	if (!ObjectClass)
-	{
-		ObjectClass = LoadObject<UClass>(nullptr, ClassName.GetData());
-	}
+	UClass* ObjectClass = FindObjectClass(ClassName);
 	if (!ObjectClass)
 	{
 		return;
@@ -24,3 +24,46 @@ void FLoadInfosAction::UpdateOperation(FLatentResponse& Response)
 	Response.FinishAndTriggerIf(bFinished, ExecutionFunction, OutputLink, CallbackTarget);
 
 }
+
+
+FLoadSummariesAction::FLoadSummariesAction(USaveManager* Manager, const bool bSortByRecent, TArray<FSlotSummary>& InSummaries, ELoadInfoResult& OutResult, const FLatentActionInfo& LatentInfo)
+	: Result(OutResult)
+	, Summaries(InSummaries)
+	, bFinished(false)
+	, ExecutionFunction(LatentInfo.ExecutionFunction)
+	, OutputLink(LatentInfo.Linkage)
+	, CallbackTarget(LatentInfo.CallbackTarget)
+{
+	Manager->LoadAllSlotSummaries(bSortByRecent, FOnSlotSummariesLoaded::CreateLambda([this](const TArray<FSlotSummary>& Results) {
+		Summaries = Results;
+		bFinished = true;
+	}));
+}
+
+void FLoadSummariesAction::UpdateOperation(FLatentResponse& Response)
+{
+	Response.FinishAndTriggerIf(bFinished, ExecutionFunction, OutputLink, CallbackTarget);
+}
+
+
+FQuerySlotsAction::FQuerySlotsAction(USaveManager* Manager, const FSlotQuery& Query, TArray<FSlotSummary>& InPage, int32& OutNumMatches, ELoadInfoResult& OutResult, const FLatentActionInfo& LatentInfo)
+	: Result(OutResult)
+	, Page(InPage)
+	, NumMatches(OutNumMatches)
+	, bFinished(false)
+	, ExecutionFunction(LatentInfo.ExecutionFunction)
+	, OutputLink(LatentInfo.Linkage)
+	, CallbackTarget(LatentInfo.CallbackTarget)
+{
+	// May finish immediately if the slot index is already built
+	Manager->QuerySlots(Query, FOnSlotsQueried::CreateLambda([this](const TArray<FSlotSummary>& Results, int32 InNumMatches) {
+		Page = Results;
+		NumMatches = InNumMatches;
+		bFinished = true;
+	}));
+}
+
+void FQuerySlotsAction::UpdateOperation(FLatentResponse& Response)
+{
+	Response.FinishAndTriggerIf(bFinished, ExecutionFunction, OutputLink, CallbackTarget);
+}
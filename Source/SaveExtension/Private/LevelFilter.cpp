@@ -10,3 +10,4 @@ const FName FSELevelFilter::TagNoTransform { "!SaveTransform"  };
 const FName FSELevelFilter::TagNoPhysics   { "!SavePhysics"    };
 const FName FSELevelFilter::TagNoTags      { "!SaveTags"       };
 const FName FSELevelFilter::TagTransform   { "SaveTransform"   };
+const FName FSELevelFilter::TagPooled      { "SavePooled"      };
@@ -0,0 +1,148 @@
+// Copyright 2015-2020 Piperift. All Rights Reserved.
+
+#include "Misc/ActorPool.h"
+#include <Components/ActorComponent.h>
+#include <Engine/World.h>
+#include <TimerManager.h>
+#include <UObject/UObjectGlobals.h>
+
+#include "LevelFilter.h"
+
+
+/////////////////////////////////////////////////////
+// FSEActorPool
+
+bool FSEActorPool::Release(AActor* Actor, int32 MaxPerClass)
+{
+	check(Actor);
+
+	TArray<FPooledActor>& ClassActors = Actors.FindOrAdd(Actor->GetClass());
+	if (ClassActors.Num() >= MaxPerClass)
+	{
+		// Forget destroyed actors before deciding the pool is full
+		ClassActors.RemoveAllSwap([](const FPooledActor& Pooled) {
+			return !Pooled.Actor.IsValid();
+		});
+		if (ClassActors.Num() >= MaxPerClass)
+		{
+			return false;
+		}
+	}
+
+	ClassActors.Add({ Actor, Actor->GetActorEnableCollision() });
+	Deactivate(Actor);
+	return true;
+}
+
+AActor* FSEActorPool::Acquire(UClass* Class, const ULevel* Level, FName Name)
+{
+	TArray<FPooledActor>* const ClassActors = Actors.Find(Class);
+	if (!ClassActors)
+	{
+		return nullptr;
+	}
+
+	int32 FoundIndex = INDEX_NONE;
+	for (int32 I = ClassActors->Num() - 1; I >= 0; --I)
+	{
+		const AActor* const Actor = (*ClassActors)[I].Actor.Get();
+		if (!IsValid(Actor) || Actor->IsPendingKillPending())
+		{
+			ClassActors->RemoveAtSwap(I, 1, false);
+			if (FoundIndex == ClassActors->Num())
+			{
+				// The found actor was swapped into this index
+				FoundIndex = I;
+			}
+			continue;
+		}
+
+		if (Actor->GetLevel() == Level)
+		{
+			if (Actor->GetFName() == Name)
+			{
+				FoundIndex = I;
+				break;
+			}
+			else if (FoundIndex == INDEX_NONE)
+			{
+				FoundIndex = I;
+			}
+		}
+	}
+
+	if (FoundIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	const FPooledActor Pooled = (*ClassActors)[FoundIndex];
+	AActor* const Actor = Pooled.Actor.Get();
+	ClassActors->RemoveAtSwap(FoundIndex, 1, false);
+
+	// Take the requested name if nothing else in the level uses it
+	if (Actor->GetFName() != Name && !StaticFindObjectFast(nullptr, Actor->GetOuter(), Name))
+	{
+		Actor->Rename(*Name.ToString(), nullptr,
+			REN_DontCreateRedirectors | REN_ForceNoResetLoaders | REN_NonTransactional | REN_DoNotDirty);
+	}
+
+	Reactivate(Actor, Pooled.bCollisionEnabled);
+	return Actor;
+}
+
+void FSEActorPool::DestroyAll()
+{
+	for (const auto& ClassActors : Actors)
+	{
+		for (const FPooledActor& Pooled : ClassActors.Value)
+		{
+			if (AActor* const Actor = Pooled.Actor.Get())
+			{
+				Actor->Destroy();
+			}
+		}
+	}
+	Actors.Empty();
+}
+
+void FSEActorPool::Deactivate(AActor* Actor)
+{
+	Actor->Tags.AddUnique(FSELevelFilter::TagPooled);
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+
+	UWorld* const World = Actor->GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearAllTimersForObject(Actor);
+	}
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component)
+		{
+			Component->SetComponentTickEnabled(false);
+			if (World)
+			{
+				World->GetTimerManager().ClearAllTimersForObject(Component);
+			}
+		}
+	}
+}
+
+void FSEActorPool::Reactivate(AActor* Actor, bool bCollisionEnabled)
+{
+	// Tags, visibility and the rest of the state will be restored by deserialization
+	Actor->Tags.Remove(FSELevelFilter::TagPooled);
+	Actor->SetActorHiddenInGame(false);
+	Actor->SetActorEnableCollision(bCollisionEnabled);
+	Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (Component)
+		{
+			Component->SetComponentTickEnabled(Component->PrimaryComponentTick.bStartWithTickEnabled);
+		}
+	}
+}
@@ -0,0 +1,197 @@
+// Copyright 2015-2020 Piperift. All Rights Reserved.
+
+#include "Misc/RecordSpillFile.h"
+
+#include "ISaveExtension.h"
+
+#include <Algo/BinarySearch.h>
+#include <Async/Async.h>
+#include <HAL/FileManager.h>
+#include <HAL/PlatformFileManager.h>
+#include <Misc/Guid.h>
+#include <Misc/Paths.h>
+#include <Misc/ScopeLock.h>
+
+
+FSERecordSpillFile::FSERecordSpillFile()
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	Path = GetDirectory() / FString::Printf(TEXT("Records-%s.tmp"), *FGuid::NewGuid().ToString());
+	PlatformFile.CreateDirectoryTree(*GetDirectory());
+	Handle.Reset(PlatformFile.OpenWrite(*Path, false, true));
+	if (!Handle)
+	{
+		UE_LOG(LogSaveExtension, Warning, TEXT("Failed to create record spill file '%s'"), *Path);
+	}
+}
+
+FSERecordSpillFile::~FSERecordSpillFile()
+{
+	// Pending writes keep the file alive, so none is left here
+	Handle.Reset();
+	FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*Path);
+}
+
+void FSERecordSpillFile::DeleteLeftovers()
+{
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *(GetDirectory() / TEXT("Records-*.tmp")), true, false);
+	for (const FString& File : Files)
+	{
+		IFileManager::Get().Delete(*(GetDirectory() / File), false, false, true);
+	}
+}
+
+int64 FSERecordSpillFile::Append(TArray<uint8>&& Bytes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSERecordSpillFile::Append);
+	if (!Handle)
+	{
+		return INDEX_NONE;
+	}
+
+	TSharedRef<const TArray<uint8>, ESPMode::ThreadSafe> Pending = MakeShared<const TArray<uint8>, ESPMode::ThreadSafe>(MoveTemp(Bytes));
+	int64 Offset;
+	{
+		FScopeLock ScopeLock(&PendingLock);
+		Offset = Reserve(Pending->Num());
+		PendingWrites.Add(Offset, Pending);
+	}
+
+	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [File = AsShared(), Offset, Pending]() {
+		File->Write(Offset, *Pending);
+	});
+	return Offset;
+}
+
+bool FSERecordSpillFile::Read(int64 Offset, int32 Num, TArray<uint8>& OutBytes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSERecordSpillFile::Read);
+	int64 WrittenSize;
+	{
+		FScopeLock ScopeLock(&PendingLock);
+		if (const auto* Pending = PendingWrites.Find(Offset))
+		{
+			OutBytes = **Pending;
+			return OutBytes.Num() == Num;
+		}
+		WrittenSize = Size;
+	}
+
+	FScopeLock ScopeLock(&FileLock);
+	OutBytes.SetNumUninitialized(Num);
+	if (!Handle || Offset < 0 || Offset + Num > WrittenSize || !Handle->Seek(Offset) || !Handle->Read(OutBytes.GetData(), Num))
+	{
+		OutBytes.Reset();
+		return false;
+	}
+	return true;
+}
+
+void FSERecordSpillFile::Free(int64 Offset, int32 Num)
+{
+	FScopeLock ScopeLock(&PendingLock);
+	if (PendingWrites.Contains(Offset))
+	{
+		// Reusing it now could let the pending write overwrite newer bytes
+		FreedPendingWrites.Add(Offset, Num);
+		return;
+	}
+	AddFreeRange(Offset, Num);
+}
+
+bool FSERecordSpillFile::HasPendingWrites()
+{
+	FScopeLock ScopeLock(&PendingLock);
+	return PendingWrites.Num() > 0;
+}
+
+FString FSERecordSpillFile::GetDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveExtension");
+}
+
+void FSERecordSpillFile::Write(int64 Offset, const TArray<uint8>& Bytes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSERecordSpillFile::Write);
+
+	bool bWritten;
+	{
+		FScopeLock ScopeLock(&FileLock);
+		bWritten = Handle->Seek(Offset) && Handle->Write(Bytes.GetData(), Bytes.Num());
+	}
+
+	FScopeLock ScopeLock(&PendingLock);
+	if (!bWritten)
+	{
+		UE_LOG(LogSaveExtension, Warning, TEXT("Failed to write records to spill file '%s'"), *Path);
+		if (!FreedPendingWrites.Contains(Offset))
+		{
+			// Kept in memory, where they can still be read
+			return;
+		}
+	}
+
+	PendingWrites.Remove(Offset);
+	int32 FreedNum = 0;
+	if (FreedPendingWrites.RemoveAndCopyValue(Offset, FreedNum))
+	{
+		AddFreeRange(Offset, FreedNum);
+	}
+}
+
+int64 FSERecordSpillFile::Reserve(int64 Num)
+{
+	// First range where the bytes fit
+	for (int32 I = 0; I < FreeRanges.Num(); ++I)
+	{
+		FFreeRange& Range = FreeRanges[I];
+		if (Num > 0 && Range.Size >= Num)
+		{
+			const int64 Offset = Range.Offset;
+			Range.Offset += Num;
+			Range.Size -= Num;
+			if (Range.Size <= 0)
+			{
+				FreeRanges.RemoveAt(I);
+			}
+			return Offset;
+		}
+	}
+
+	const int64 Offset = Size;
+	Size += Num;
+	return Offset;
+}
+
+void FSERecordSpillFile::AddFreeRange(int64 Offset, int64 Num)
+{
+	if (Offset < 0 || Num <= 0)
+	{
+		return;
+	}
+
+	int32 Index = Algo::LowerBoundBy(FreeRanges, Offset, &FFreeRange::Offset);
+	FreeRanges.Insert({ Offset, Num }, Index);
+
+	// Merged with contiguous ranges
+	if (Index + 1 < FreeRanges.Num() && FreeRanges[Index].Offset + FreeRanges[Index].Size == FreeRanges[Index + 1].Offset)
+	{
+		FreeRanges[Index].Size += FreeRanges[Index + 1].Size;
+		FreeRanges.RemoveAt(Index + 1);
+	}
+	if (Index > 0 && FreeRanges[Index - 1].Offset + FreeRanges[Index - 1].Size == FreeRanges[Index].Offset)
+	{
+		FreeRanges[Index - 1].Size += FreeRanges[Index].Size;
+		FreeRanges.RemoveAt(Index);
+		--Index;
+	}
+
+	// Space at the end is just not used anymore
+	if (FreeRanges[Index].Offset + FreeRanges[Index].Size == Size)
+	{
+		Size = FreeRanges[Index].Offset;
+		FreeRanges.RemoveAt(Index);
+	}
+}
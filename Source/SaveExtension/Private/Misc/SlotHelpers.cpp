@@ -3,8 +3,74 @@
 #include <Misc/SlotHelpers.h>
 #include <Misc/Paths.h>
 #include <HAL/PlatformFilemanager.h>
+#include <IImageWrapper.h>
+#include <IImageWrapperModule.h>
+#include <Engine/Texture2D.h>
 
 
+bool FSlotHelpers::DecodeThumbnail(IImageWrapperModule& ImageWrapperModule, const TArray<uint8>& Image,
+	int32& OutWidth, int32& OutHeight, TArray64<uint8>& OutPixels)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSlotHelpers::DecodeThumbnail);
+
+	// Thumbnails written as files are PNG, embedded ones are JPEG
+	const EImageFormat Format = ImageWrapperModule.DetectImageFormat(Image.GetData(), Image.Num());
+	if (Format == EImageFormat::Invalid)
+	{
+		return false;
+	}
+
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(Format);
+	if (ImageWrapper.IsValid() && ImageWrapper->SetCompressed(Image.GetData(), Image.Num()) &&
+		ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, OutPixels))
+	{
+		OutWidth = ImageWrapper->GetWidth();
+		OutHeight = ImageWrapper->GetHeight();
+		return true;
+	}
+	return false;
+}
+
+bool FSlotHelpers::EncodeThumbnail(IImageWrapperModule& ImageWrapperModule, int32 Width, int32 Height,
+	const TArray<FColor>& Pixels, TArray<uint8>& OutImage)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSlotHelpers::EncodeThumbnail);
+
+	OutImage.Reset();
+	if (Width <= 0 || Height <= 0 || Pixels.Num() != Width * Height)
+	{
+		return false;
+	}
+
+	TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::JPEG);
+	if (!ImageWrapper.IsValid() ||
+		!ImageWrapper->SetRaw(Pixels.GetData(), Pixels.Num() * sizeof(FColor), Width, Height, ERGBFormat::BGRA, 8))
+	{
+		return false;
+	}
+
+	const TArray64<uint8> Compressed = ImageWrapper->GetCompressed(85);
+	OutImage.Append(Compressed.GetData(), int32(Compressed.Num()));
+	return OutImage.Num() > 0;
+}
+
+UTexture2D* FSlotHelpers::CreateThumbnailTexture(int32 Width, int32 Height, const TArray64<uint8>& Pixels)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSlotHelpers::CreateThumbnailTexture);
+
+	if (Width <= 0 || Height <= 0 || Pixels.Num() != int64(Width) * Height * 4)
+	{
+		return nullptr;
+	}
+
+	UTexture2D* Texture = UTexture2D::CreateTransient(Width, Height, PF_B8G8R8A8);
+	void* TextureData = Texture->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
+	FMemory::Memcpy(TextureData, Pixels.GetData(), Pixels.Num());
+	Texture->GetPlatformData()->Mips[0].BulkData.Unlock();
+	Texture->UpdateResource();
+	return Texture;
+}
+
 void FSlotHelpers::FindSlotFileNames(TArray<FString>& FoundSlots)
 {
 	FFindSlotVisitor Visitor{ FoundSlots };
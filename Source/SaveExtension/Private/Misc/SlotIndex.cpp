@@ -0,0 +1,138 @@
+// Copyright 2015-2020 Piperift. All Rights Reserved.
+
+#include "Misc/SlotIndex.h"
+
+#include <Algo/StableSort.h>
+
+
+void FSESlotIndex::Build(TArray<FSlotSummary> InSummaries)
+{
+	Summaries = MoveTemp(InSummaries);
+	SlotIndices.Empty(Summaries.Num());
+	for (int32 I = 0; I < Summaries.Num(); ++I)
+	{
+		SlotIndices.Add(Summaries[I].FileName, I);
+	}
+	SortedCache.Empty();
+	bBuilt = true;
+}
+
+void FSESlotIndex::Update(const FSlotSummary& Summary)
+{
+	if (!bBuilt || Summary.FileName.IsNone())
+	{
+		return;
+	}
+
+	if (const int32* Index = SlotIndices.Find(Summary.FileName))
+	{
+		Summaries[*Index] = Summary;
+	}
+	else
+	{
+		SlotIndices.Add(Summary.FileName, Summaries.Add(Summary));
+	}
+	SortedCache.Empty();
+}
+
+void FSESlotIndex::Remove(FName SlotName)
+{
+	int32 Index;
+	if (!SlotIndices.RemoveAndCopyValue(SlotName, Index))
+	{
+		return;
+	}
+
+	// Swap the last summary into the hole
+	Summaries.RemoveAtSwap(Index);
+	if (Summaries.IsValidIndex(Index))
+	{
+		SlotIndices.Add(Summaries[Index].FileName, Index);
+	}
+	SortedCache.Empty();
+}
+
+void FSESlotIndex::Reset()
+{
+	Summaries.Empty();
+	SlotIndices.Empty();
+	SortedCache.Empty();
+	bBuilt = false;
+}
+
+int32 FSESlotIndex::Query(const FSlotQuery& Query, TArray<FSlotSummary>& OutPage) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSESlotIndex::Query);
+
+	OutPage.Reset();
+	const TArray<int32>& Sorted = GetSorted(Query.SortBy, Query.bDescending);
+	const int32 Offset = FMath::Max(0, Query.Offset);
+	const int32 End = Offset + FMath::Max(0, Query.Count);
+
+	if (Query.Map.IsNone())
+	{
+		for (int32 I = Offset; I < FMath::Min(End, Sorted.Num()); ++I)
+		{
+			OutPage.Add(Summaries[Sorted[I]]);
+		}
+		return Sorted.Num();
+	}
+
+	int32 NumMatches = 0;
+	for (const int32 Index : Sorted)
+	{
+		const FSlotSummary& Summary = Summaries[Index];
+		if (Summary.Map == Query.Map)
+		{
+			if (NumMatches >= Offset && NumMatches < End)
+			{
+				OutPage.Add(Summary);
+			}
+			++NumMatches;
+		}
+	}
+	return NumMatches;
+}
+
+const TArray<int32>& FSESlotIndex::GetSorted(ESlotSortKey SortBy, bool bDescending) const
+{
+	// UI usually pages with the same sorting, so it is only sorted when it changes
+	if (SortedCache.Num() == Summaries.Num() && CachedSortKey == SortBy && bCachedDescending == bDescending)
+	{
+		return SortedCache;
+	}
+
+	SortedCache.SetNumUninitialized(Summaries.Num());
+	for (int32 I = 0; I < Summaries.Num(); ++I)
+	{
+		SortedCache[I] = I;
+	}
+
+	auto Less = [this, SortBy](int32 A, int32 B) {
+		const FSlotSummary& SA = Summaries[A];
+		const FSlotSummary& SB = Summaries[B];
+		switch (SortBy)
+		{
+			case ESlotSortKey::PlayedTime:
+				return SA.PlayedTime < SB.PlayedTime;
+			case ESlotSortKey::DisplayName:
+				return SA.DisplayName.CompareTo(SB.DisplayName) < 0;
+			case ESlotSortKey::FileName:
+				return SA.FileName.LexicalLess(SB.FileName);
+			default:
+				return SA.SaveDate < SB.SaveDate;
+		}
+	};
+	if (bDescending)
+	{
+		Algo::StableSort(SortedCache, [&Less](int32 A, int32 B) { return Less(B, A); });
+	}
+	else
+	{
+		Algo::StableSort(SortedCache, Less);
+	}
+
+	CachedSortKey = SortBy;
+	bCachedDescending = bDescending;
+	return SortedCache;
+}
@@ -0,0 +1,60 @@
+// Copyright 2015-2020 Piperift. All Rights Reserved.
+
+#include "Misc/ThumbnailCapture.h"
+
+#include "Misc/SlotHelpers.h"
+
+#include <Async/Async.h>
+#include <Engine/GameViewportClient.h>
+#include <Engine/World.h>
+#include <IImageWrapperModule.h>
+#include <ImageUtils.h>
+#include <RenderingThread.h>
+#include <UnrealClient.h>
+
+
+TSharedPtr<FSEThumbnailCapture, ESPMode::ThreadSafe> FSEThumbnailCapture::Start(const UWorld* World, int32 Width, int32 Height)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FSEThumbnailCapture::Start);
+
+	const UGameViewportClient* ViewportClient = World ? World->GetGameViewport() : nullptr;
+	FViewport* Viewport = ViewportClient ? ViewportClient->Viewport : nullptr;
+	if (!Viewport || Width <= 0 || Height <= 0)
+	{
+		return {};
+	}
+
+	TSharedRef<FSEThumbnailCapture, ESPMode::ThreadSafe> Capture = MakeShared<FSEThumbnailCapture, ESPMode::ThreadSafe>();
+	Capture->Width = Width;
+	Capture->Height = Height;
+
+	// Image wrappers can't be loaded from other threads
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	ENQUEUE_RENDER_COMMAND(SECaptureThumbnail)(
+		[Capture, Viewport, &ImageWrapperModule](FRHICommandListImmediate& RHICmdList) {
+			TRACE_CPUPROFILER_EVENT_SCOPE(FSEThumbnailCapture::ReadViewport);
+
+			const FTextureRHIRef& Texture = Viewport->GetRenderTargetTexture();
+			const FIntPoint Size = Viewport->GetSizeXY();
+			if (!Texture.IsValid() || Size.X <= 0 || Size.Y <= 0)
+			{
+				Capture->Finish({});
+				return;
+			}
+
+			TArray<FColor> Pixels;
+			RHICmdList.ReadSurfaceData(Texture, FIntRect{ FIntPoint::ZeroValue, Size }, Pixels, FReadSurfaceDataFlags{});
+
+			TArray<FColor> Downscaled;
+			FImageUtils::ImageResize(Size.X, Size.Y, Pixels, Capture->Width, Capture->Height, Downscaled, false);
+
+			// Compression doesn't need to hold the render thread
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Capture, Downscaled = MoveTemp(Downscaled), &ImageWrapperModule]() {
+				TArray<uint8> Image;
+				FSlotHelpers::EncodeThumbnail(ImageWrapperModule, Capture->Width, Capture->Height, Downscaled, Image);
+				Capture->Finish(MoveTemp(Image));
+			});
+		});
+	return Capture;
+}
@@ -36,9 +36,11 @@ void FDeleteSlotsTask::DoWork()
 		TArray<FString> FoundSlots;
 		FSlotHelpers::FindSlotFileNames(FoundSlots);
 
+		IFileManager& FileManager = IFileManager::Get();
 		for (const FString& File : FoundSlots)
 		{
 			FFileAdapter::DeleteFile(File);
+			FileManager.Delete(*FFileAdapter::GetThumbnailPath(File), false, false, true);
 		}
 		bSuccess = true;
 	}
@@ -2,8 +2,170 @@
 
 #include "Multithreading/LoadFileTask.h"
 
+#include <Async/ParallelFor.h>
+#include <Components/ActorComponent.h>
+#include <GameFramework/Actor.h>
+#include <Serialization/MemoryReader.h>
+#include <UObject/PropertyTag.h>
+
+#include "ISaveExtension.h"
 #include "SavePreset.h"
+#include "Serialization/SEArchive.h"
+
+
+namespace LoadFileTask
+{
+	/** Actor records checked by each validation batch */
+	static constexpr int32 ActorsPerBatch = 64;
+
+	struct FRecordBatch
+	{
+		const FLevelRecord* Level = nullptr;
+		int32 LevelIndex = INDEX_NONE;
+		int32 StartIndex = 0;
+		int32 Num = 0;
+	};
+
+	/** @return true if the tagged properties in the data of a record can be read until their end */
+	static bool CanReadProperties(const FObjectRecord& Record)
+	{
+		FMemoryReader MemoryReader(Record.Data, true);
+		FSEArchive Archive(MemoryReader, false);
+		const int64 TotalSize = MemoryReader.TotalSize();
+		while (true)
+		{
+			FPropertyTag Tag;
+			Archive << Tag;
+			if (Archive.IsError())
+			{
+				return false;
+			}
+			if (Tag.Name.IsNone())
+			{
+				return true;
+			}
+
+			const int64 ValueEnd = MemoryReader.Tell() + Tag.Size;
+			if (Tag.Size < 0 || Tag.ArrayIndex < 0 || ValueEnd > TotalSize)
+			{
+				return false;
+			}
+
+			// Properties removed from the class are skipped while loading. Their indices must still fit
+			const FProperty* const Property = Record.Class->FindPropertyByName(Tag.Name);
+			if (Property && Tag.ArrayIndex >= Property->ArrayDim)
+			{
+				return false;
+			}
+			MemoryReader.Seek(ValueEnd);
+		}
+	}
+
+	static bool IsValidActor(const FActorRecord& Record)
+	{
+		return Record.Class->IsChildOf<AActor>() && CanReadProperties(Record);
+	}
+
+	static bool IsValidComponent(const FComponentRecord& Record)
+	{
+		if (!Record.Class || !Record.Class->IsChildOf<UActorComponent>())
+		{
+			return false;
+		}
+		// Primitive components only store their transform and tags
+		return Record.Data.Num() <= 0 || CanReadProperties(Record);
+	}
+}
 
 
 /////////////////////////////////////////////////////
-// FSaveFileTask
+// FLoadFileTask
+
+void FLoadFileTask::ValidateRecords()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FLoadFileTask::ValidateRecords);
+
+	TArray<LoadFileTask::FRecordBatch> Batches;
+	auto AddBatches = [&Batches](const FLevelRecord& Level, int32 LevelIndex) {
+		// The first batch also checks the level script
+		int32 StartIndex = 0;
+		do
+		{
+			const int32 Num = FMath::Min(LoadFileTask::ActorsPerBatch, Level.Actors.Num() - StartIndex);
+			Batches.Add({ &Level, LevelIndex, StartIndex, Num });
+			StartIndex += Num;
+		}
+		while (StartIndex < Level.Actors.Num());
+	};
+
+	AddBatches(Records.MainLevel, INDEX_NONE);
+	for (int32 I = 0; I < Records.SubLevels.Num(); ++I)
+	{
+		// Encoded levels are decoded later on the game thread
+		if (!Records.SubLevels[I].IsEncoded())
+		{
+			AddBatches(Records.SubLevels[I], I);
+		}
+	}
+
+	// Each batch stages what it finds apart, so that records are only modified by GetData()
+	InvalidRecords.SetNum(Batches.Num());
+	ParallelFor(Batches.Num(), [this, &Batches](int32 BatchIndex) {
+		const LoadFileTask::FRecordBatch& Batch = Batches[BatchIndex];
+		TArray<FInvalidRecord>& Invalid = InvalidRecords[BatchIndex];
+
+		auto ValidateActor = [&Batch, &Invalid](const FActorRecord& Record, int32 ActorIndex) {
+			if (!Record.IsValid())
+			{
+				// Not loaded anyway
+				return;
+			}
+			if (!LoadFileTask::IsValidActor(Record))
+			{
+				Invalid.Add({ Batch.LevelIndex, ActorIndex });
+				return;
+			}
+			for (int32 I = 0; I < Record.ComponentRecords.Num(); ++I)
+			{
+				const FComponentRecord& Component = Record.ComponentRecords[I];
+				if (!Component.Name.IsNone() && !LoadFileTask::IsValidComponent(Component))
+				{
+					Invalid.Add({ Batch.LevelIndex, ActorIndex, I });
+				}
+			}
+		};
+
+		if (Batch.StartIndex == 0)
+		{
+			ValidateActor(Batch.Level->LevelScript, INDEX_NONE);
+		}
+		for (int32 I = Batch.StartIndex; I < Batch.StartIndex + Batch.Num; ++I)
+		{
+			ValidateActor(Batch.Level->Actors[I], I);
+		}
+	});
+}
+
+void FLoadFileTask::DiscardInvalidRecords()
+{
+	for (const TArray<FInvalidRecord>& Batch : InvalidRecords)
+	{
+		for (const FInvalidRecord& Invalid : Batch)
+		{
+			FLevelRecord& Level = Invalid.LevelIndex == INDEX_NONE
+				? static_cast<FLevelRecord&>(Records.MainLevel)
+				: static_cast<FLevelRecord&>(Records.SubLevels[Invalid.LevelIndex]);
+			FActorRecord& Actor = Invalid.ActorIndex == INDEX_NONE ? Level.LevelScript : Level.Actors[Invalid.ActorIndex];
+			FObjectRecord& Record = Invalid.ComponentIndex == INDEX_NONE
+				? static_cast<FObjectRecord&>(Actor)
+				: static_cast<FObjectRecord&>(Actor.ComponentRecords[Invalid.ComponentIndex]);
+
+			UE_LOG(LogSaveExtension, Warning, TEXT("Record '%s' (%s) in level '%s' can't be loaded. Its class changed or its data is corrupted"),
+				*Record.Name.ToString(), *GetNameSafe(Record.Class), *Level.Name.ToString());
+
+			// Records without data are not applied
+			Record.Data.Empty();
+		}
+	}
+	InvalidRecords.Empty();
+}
@@ -2,6 +2,8 @@
 
 #include "Multithreading/LoadSlotInfosTask.h"
 
+#include <Async/ParallelFor.h>
+#include <HAL/FileManager.h>
 #include <HAL/PlatformFilemanager.h>
 
 #include "FileAdapter.h"
@@ -28,39 +30,70 @@ void FLoadSlotInfosTask::DoWork()
 		FSlotHelpers::FindSlotFileNames(FileNames);
 	}
 
-	TArray<FSaveFile> LoadedFiles;
-	LoadedFiles.Reserve(FileNames.Num());
-	for (const FString& FileName : FileNames)
-	{
-		// Load all files
-		FScopedFileReader Reader(FFileAdapter::GetSlotPath(FileName));
-		if(Reader.IsValid())
+	// Read all headers in parallel. Opening files is usually slower than reading them.
+	// Recently read ones come from the cache
+	TArray<FDateTime> SaveDates;
+	LoadedFiles.SetNum(FileNames.Num());
+	SaveDates.SetNum(FileNames.Num());
+	ParallelFor(FileNames.Num(), [this, &FileNames, &LoadedFiles, &SaveDates](int32 Index) {
+		const FString& FileName = FileNames[Index];
+		LoadedFiles[Index] = FFileAdapter::ReadFile(FileName, true);
+		if (LoadedFiles[Index] && bSortByRecent)
 		{
-			auto& File = LoadedFiles.AddDefaulted_GetRef();
-			File.Read(Reader, true);
+			SaveDates[Index] = LoadedFiles[Index]->Summary.SaveDate;
+			if (SaveDates[Index].GetTicks() <= 0)
+			{
+				// Older files don't have it on their header
+				SaveDates[Index] = IFileManager::Get().GetTimeStamp(*FFileAdapter::GetSlotPath(FileName));
+			}
 		}
-	}
+	});
 
-	// For cache friendlyness, we deserialize infos after loading all the files
-	LoadedSlots.Reserve(LoadedFiles.Num());
-	for (const auto& File : LoadedFiles)
+	// Sorted before creating any info
+	TArray<int32> Order;
+	Order.Reserve(LoadedFiles.Num());
+	for (int32 I = 0; I < LoadedFiles.Num(); ++I)
 	{
-		LoadedSlots.Add(File.CreateAndDeserializeInfo(Manager));
+		if (LoadedFiles[I])
+		{
+			Order.Add(I);
+		}
 	}
-
 	if (!bLoadingSingleInfo && bSortByRecent)
 	{
-		LoadedSlots.Sort([](const USlotInfo& A, const USlotInfo& B) {
-			return A.SaveDate > B.SaveDate;
+		Order.Sort([&SaveDates](int32 A, int32 B) {
+			return SaveDates[A] > SaveDates[B];
 		});
 	}
+
+	TArray<TSharedPtr<const FSaveFile>> SortedFiles;
+	SortedFiles.Reserve(Order.Num());
+	for (const int32 Index : Order)
+	{
+		SortedFiles.Add(MoveTemp(LoadedFiles[Index]));
+	}
+	LoadedFiles = MoveTemp(SortedFiles);
 }
 
 void FLoadSlotInfosTask::AfterFinish()
 {
-	for(auto& Slot : LoadedSlots)
+	CreateInfos();
+	Delegate.ExecuteIfBound(LoadedSlots);
+}
+
+void FLoadSlotInfosTask::CreateInfos()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FLoadSlotInfosTask::CreateInfos);
+	check(IsInGameThread());
+
+	// Infos are small. Creating them here avoids creating objects on other threads
+	LoadedSlots.Reserve(LoadedFiles.Num());
+	for (const auto& File : LoadedFiles)
 	{
-		Slot->ClearInternalFlags(EInternalObjectFlags::Async);
+		if (USlotInfo* Info = File->CreateAndDeserializeInfo(Manager))
+		{
+			LoadedSlots.Add(Info);
+		}
 	}
-	Delegate.ExecuteIfBound(LoadedSlots);
+	LoadedFiles.Empty();
 }
@@ -0,0 +1,78 @@
+// Copyright 2015-2020 Piperift. All Rights Reserved.
+
+#include "Multithreading/LoadSlotSummariesTask.h"
+
+#include <Async/ParallelFor.h>
+
+#include "FileAdapter.h"
+#include "SaveManager.h"
+#include "Misc/SlotHelpers.h"
+
+
+void FLoadSlotSummariesTask::DoWork()
+{
+	if (!Manager)
+	{
+		return;
+	}
+
+	TArray<FString> FileNames;
+	const bool bLoadingSingleSummary = !SlotName.IsNone();
+	if (bLoadingSingleSummary)
+	{
+		FileNames.Add(SlotName.ToString());
+	}
+	else
+	{
+		FSlotHelpers::FindSlotFileNames(FileNames);
+	}
+
+	TArray<TSharedPtr<const FSaveFile>> LoadedFiles;
+	LoadedFiles.SetNum(FileNames.Num());
+	ParallelFor(FileNames.Num(), [&FileNames, &LoadedFiles](int32 Index) {
+		LoadedFiles[Index] = FFileAdapter::ReadFile(FileNames[Index], true);
+	});
+
+	Summaries.Reserve(LoadedFiles.Num());
+	for (int32 I = 0; I < LoadedFiles.Num(); ++I)
+	{
+		const TSharedPtr<const FSaveFile>& File = LoadedFiles[I];
+		if (!File)
+		{
+			continue;
+		}
+
+		if (File->HasSummary())
+		{
+			Summaries.Add(File->Summary);
+		}
+		else if (USlotInfo* Info = File->CreateAndDeserializeInfo(Manager))
+		{
+			LegacyInfos.Add(Info);
+			Summaries.Emplace(*Info);
+		}
+		else
+		{
+			continue;
+		}
+		Summaries.Last().FileName = FName{ FileNames[I] };
+	}
+
+	if (!bLoadingSingleSummary && bSortByRecent)
+	{
+		Summaries.Sort([](const FSlotSummary& A, const FSlotSummary& B) {
+			return A.SaveDate > B.SaveDate;
+		});
+	}
+}
+
+void FLoadSlotSummariesTask::AfterFinish()
+{
+	// Legacy infos are not kept, let them be collected
+	for (USlotInfo* Info : LegacyInfos)
+	{
+		Info->ClearInternalFlags(EInternalObjectFlags::Async);
+	}
+	LegacyInfos.Empty();
+	Delegate.ExecuteIfBound(Summaries);
+}
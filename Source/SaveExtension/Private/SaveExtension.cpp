@@ -2,7 +2,16 @@
 
 #include "SaveExtension.h"
 
+#include "Misc/RecordSpillFile.h"
+
 
 DEFINE_LOG_CATEGORY(LogSaveExtension)
 
 IMPLEMENT_MODULE(FSaveExtension, SaveExtension);
+
+
+void FSaveExtension::StartupModule()
+{
+	// Records spilled by sessions that crashed are never read again
+	FSERecordSpillFile::DeleteLeftovers();
+}
@@ -15,7 +15,7 @@ class FSaveExtension : public ISaveExtension
 {
 public:
 
-	virtual void StartupModule() override {}
+	virtual void StartupModule() override;
 	virtual void ShutdownModule() override {}
 
 	virtual bool SupportsDynamicReloading() override { return true; }
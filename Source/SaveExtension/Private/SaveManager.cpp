@@ -6,10 +6,13 @@
 #include "LatentActions/LoadInfosAction.h"
 #include "Multithreading/DeleteSlotsTask.h"
 #include "Multithreading/LoadSlotInfosTask.h"
+#include "Multithreading/LoadSlotSummariesTask.h"
+#include "Multithreading/LoadThumbnailTask.h"
 #include "SaveSettings.h"
 #include "Serialization/SlotDataTask_LevelLoader.h"
 #include "Serialization/SlotDataTask_LevelSaver.h"
 #include "Serialization/SlotDataTask_Loader.h"
+#include "Serialization/SlotDataTask_RecordsTrimmer.h"
 #include "Serialization/SlotDataTask_Saver.h"
 
 #include <Engine/GameViewportClient.h>
@@ -17,8 +20,10 @@
 #include <EngineUtils.h>
 #include <GameDelegates.h>
 #include <GameFramework/GameModeBase.h>
+#include <HAL/FileManager.h>
 #include <HighResScreenshot.h>
 #include <Kismet/GameplayStatics.h>
+#include <Misc/App.h>
 #include <Misc/CoreDelegates.h>
 #include <Misc/Paths.h>
 
@@ -30,6 +35,7 @@ void USaveManager::Initialize(FSubsystemCollectionBase& Collection)
 	Super::Initialize(Collection);
 
 	bTickWithGameWorld = GetDefault<USaveSettings>()->bTickWithGameWorld;
+	FFileAdapter::SetFileCacheBudget(int64(GetDefault<USaveSettings>()->FileCacheSizeMB) * 1024 * 1024);
 
 	FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &USaveManager::OnMapLoadStarted);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &USaveManager::OnMapLoadFinished);
@@ -53,11 +59,16 @@ void USaveManager::Deinitialize()
 	MTTasks.CancelAll();
 
 	if (GetPreset()->bSaveOnExit)
-		SaveCurrentSlot();
+		EmergencySave();
 
 	FCoreUObjectDelegates::PreLoadMap.RemoveAll(this);
 	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
 	FGameDelegates::Get().GetEndPlayMapDelegate().RemoveAll(this);
+
+	FFileAdapter::ClearFileCache();
+	ThumbnailCache.Empty();
+	RecordSpillFile.Reset();
+	PendingThumbnails.Empty();
 }
 
 bool USaveManager::SaveSlot(
@@ -79,6 +90,14 @@ bool USaveManager::SaveSlot(
 	UWorld* World = GetWorld();
 	check(World);
 
+	// A save to the same slot is waiting. It will already save the latest state
+	if (USlotDataTask_Saver* PendingSave = FindPendingSave(SlotName))
+	{
+		SELog(Preset, "Slot " + SlotName.ToString() + " was already waiting to be saved. Merged both saves.", FColor::White, false, 1);
+		PendingSave->Coalesce(bOverrideIfNeeded, bScreenshot, Size.Width, Size.Height)->Bind(OnSaved);
+		return true;
+	}
+
 	// Launch task, always fail if it didn't finish or wasn't scheduled
 	auto* Task = CreateTask<USlotDataTask_Saver>()
 		->Setup(SlotName, bOverrideIfNeeded, bScreenshot, Size.Width, Size.Height)
@@ -88,9 +107,160 @@ bool USaveManager::SaveSlot(
 	return Task->IsSucceeded() || Task->IsScheduled();
 }
 
+EEmergencySaveResult USaveManager::EmergencySave(FName SlotName)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(USaveManager::EmergencySave);
+	const double StartTime = FPlatformTime::Seconds();
+
+	const USavePreset* Preset = GetPreset();
+
+	// A slot being loaded would be saved half restored. Streamed levels are finished instead
+	const bool bLoadingSlot = Tasks.ContainsByPredicate([](const USlotDataTask* Task) {
+		return Task->IsA<USlotDataTask_Loader>() && !Task->IsA<USlotDataTask_LevelLoader>();
+	});
+	if (!CanLoadOrSave() || bLoadingSlot)
+	{
+		SELog(Preset, "Can't do an emergency save while loading a slot", true);
+		return EEmergencySaveResult::Failed;
+	}
+
+	TryInstantiateInfo();
+	if (SlotName.IsNone())
+	{
+		SlotName = CurrentInfo->FileName;
+	}
+	if (SlotName.IsNone())
+	{
+		Preset->BPGetAutoSaveSlotName(0, SlotName);
+	}
+
+	SELog(Preset, "Emergency Saving to Slot " + SlotName.ToString());
+
+	// This save replaces all waiting ones. The rest must not access records while saving
+	CancelPendingSaves();
+	if (!FinishAllTasks())
+	{
+		SELog(Preset, "Emergency save failed. Previous tasks could not be finished", true);
+		return EEmergencySaveResult::Failed;
+	}
+
+	USavePreset* FastPreset = DuplicateObject<USavePreset>(Preset, this);
+	FastPreset->bUseCompression = false;
+	FastPreset->MultithreadedSerialization = ESaveASyncMode::SaveAsync;
+	FastPreset->FrameSplittedSerialization = ESaveASyncMode::OnlySync;
+	FastPreset->MultithreadedFiles = ESaveASyncMode::OnlySync;
+
+	auto* Task = CreateTask<USlotDataTask_Saver>();
+	Task->Prepare(CurrentData, *FastPreset);
+	Task->Setup(SlotName, true, false, 0, 0)->Start();
+
+	const double Duration = FPlatformTime::Seconds() - StartTime;
+	if (!Task->IsSucceeded())
+	{
+		SELog(Preset, "Emergency save failed", true);
+		return EEmergencySaveResult::Failed;
+	}
+	if (Duration > Preset->EmergencySaveDeadline)
+	{
+		UE_LOG(LogSaveExtension, Warning, TEXT("Emergency save took %.2fs. Expected less than %.2fs"),
+			Duration, Preset->EmergencySaveDeadline);
+		return EEmergencySaveResult::SavedLate;
+	}
+	return EEmergencySaveResult::Saved;
+}
+
+bool USaveManager::AutoSave()
+{
+	AutoSaveTime = 0.f;
+
+	const USavePreset* Preset = GetPreset();
+	const int32 NumSlots = FMath::Max(1, Preset->AutoSaveSlots);
+	if (NextAutoSaveIndex == INDEX_NONE || NextAutoSaveIndex >= NumSlots)
+	{
+		NextAutoSaveIndex = FindOldestAutoSave();
+	}
+
+	FName SlotName;
+	Preset->BPGetAutoSaveSlotName(NextAutoSaveIndex, SlotName);
+	NextAutoSaveIndex = (NextAutoSaveIndex + 1) % NumSlots;
+
+	return SaveSlot(SlotName);
+}
+
+void USaveManager::UpdateAutoSave(float DeltaTime)
+{
+	const USavePreset* Preset = GetPreset();
+	if (!Preset->bAutoSave || Preset->AutoSaveInterval <= 0)
+	{
+		return;
+	}
+
+	{ // Frame times of the last half second and the last ten seconds
+		const float FrameTime = FApp::GetDeltaTime();
+		if (AverageFrameTime <= 0.f)
+		{
+			RecentFrameTime = AverageFrameTime = FrameTime;
+		}
+		RecentFrameTime = FMath::Lerp(RecentFrameTime, FrameTime, FMath::Min(1.f, FrameTime / 0.5f));
+		AverageFrameTime = FMath::Lerp(AverageFrameTime, FrameTime, FMath::Min(1.f, FrameTime / 10.f));
+	}
+
+	AutoSaveTime += DeltaTime;
+	const float Delay = AutoSaveTime - Preset->AutoSaveInterval;
+	if (Delay < 0.f)
+	{
+		return;
+	}
+
+	const bool bLowLoad = !HasTasks() && !IsAsyncLoading() && RecentFrameTime <= AverageFrameTime;
+	if (bLowLoad || Delay >= Preset->AutoSaveMaxDelay)
+	{
+		SELog(Preset, "AutoSaving" + FString(bLowLoad ? "" : " after waiting for low load"));
+		AutoSave();
+	}
+}
+
+int32 USaveManager::FindOldestAutoSave() const
+{
+	const USavePreset* Preset = GetPreset();
+
+	int32 OldestIndex = 0;
+	FDateTime OldestDate = FDateTime::MaxValue();
+	for (int32 I = 0; I < FMath::Max(1, Preset->AutoSaveSlots); ++I)
+	{
+		FName SlotName;
+		Preset->BPGetAutoSaveSlotName(I, SlotName);
+
+		// Slots never saved return MinValue
+		const FDateTime Date = IFileManager::Get().GetTimeStamp(*FFileAdapter::GetSlotPath(SlotName.ToString()));
+		if (Date < OldestDate)
+		{
+			OldestIndex = I;
+			OldestDate = Date;
+		}
+	}
+	return OldestIndex;
+}
+
+int32 USaveManager::CancelPendingSaves(FName SlotName)
+{
+	int32 NumCancelled = 0;
+	const TArray<USlotDataTask*> PendingTasks = Tasks;
+	for (USlotDataTask* Task : PendingTasks)
+	{
+		auto* Saver = Cast<USlotDataTask_Saver>(Task);
+		if (Saver && Saver->CanCoalesce() && (SlotName.IsNone() || Saver->GetSlotName() == SlotName) && Saver->Cancel())
+		{
+			++NumCancelled;
+		}
+	}
+	return NumCancelled;
+}
+
 bool USaveManager::LoadSlot(FName SlotName, FOnGameLoaded OnLoaded)
 {
-	if (!CanLoadOrSave() || !IsSlotSaved(SlotName))
+	// Existence of the slot is checked when its file is read. OnLoaded fails if it doesn't
+	if (!CanLoadOrSave() || SlotName.IsNone())
 	{
 		return false;
 	}
@@ -119,6 +289,18 @@ bool USaveManager::DeleteSlot(FName SlotName)
 		})
 		.StartSynchronousTask();
 	MTTasks.Tick();
+
+	if (bSuccess)
+	{
+		if (bBuildingSlotIndex)
+		{
+			PendingSlotIndexChanges.Add(SlotName, {});
+		}
+		SlotIndex.Remove(SlotName);
+		ThumbnailCache.RemoveAll([SlotName](const FSEThumbnailCacheEntry& Entry) {
+			return Entry.SlotName == SlotName;
+		});
+	}
 	return bSuccess;
 }
 
@@ -141,15 +323,248 @@ void USaveManager::LoadAllSlotInfosSync(bool bSortByRecent, FOnSlotInfosLoaded D
 	MTTasks.Tick();
 }
 
+void USaveManager::LoadAllSlotSummaries(bool bSortByRecent, FOnSlotSummariesLoaded Delegate)
+{
+	MTTasks.CreateTask<FLoadSlotSummariesTask>(this, bSortByRecent, MoveTemp(Delegate))
+		.OnFinished([](auto& Task) {
+			Task->AfterFinish();
+		})
+		.StartBackgroundTask();
+}
+
+void USaveManager::LoadAllSlotSummariesSync(bool bSortByRecent, FOnSlotSummariesLoaded Delegate)
+{
+	MTTasks.CreateTask<FLoadSlotSummariesTask>(this, bSortByRecent, MoveTemp(Delegate))
+		.OnFinished([](auto& Task) {
+			Task->AfterFinish();
+		})
+		.StartSynchronousTask();
+	MTTasks.Tick();
+}
+
+void USaveManager::QuerySlots(const FSlotQuery& Query, FOnSlotsQueried Delegate)
+{
+	if (SlotIndex.IsBuilt())
+	{
+		TArray<FSlotSummary> Page;
+		const int32 NumMatches = SlotIndex.Query(Query, Page);
+		Delegate.ExecuteIfBound(Page, NumMatches);
+		return;
+	}
+
+	PendingSlotQueries.Emplace(Query, MoveTemp(Delegate));
+	RefreshSlotIndex();
+}
+
+void USaveManager::RefreshSlotIndex()
+{
+	if (bBuildingSlotIndex)
+	{
+		return;
+	}
+
+	bBuildingSlotIndex = true;
+	LoadAllSlotSummaries(false, FOnSlotSummariesLoaded::CreateWeakLambda(this, [this](const TArray<FSlotSummary>& Summaries) {
+		bBuildingSlotIndex = false;
+		SlotIndex.Build(Summaries);
+		for (const auto& Change : PendingSlotIndexChanges)
+		{
+			if (Change.Value.IsSet())
+			{
+				SlotIndex.Update(Change.Value.GetValue());
+			}
+			else
+			{
+				SlotIndex.Remove(Change.Key);
+			}
+		}
+		PendingSlotIndexChanges.Empty();
+
+		TArray<FSlotSummary> Page;
+		const TArray<TPair<FSlotQuery, FOnSlotsQueried>> Queries = MoveTemp(PendingSlotQueries);
+		for (const auto& Pending : Queries)
+		{
+			const int32 NumMatches = SlotIndex.Query(Pending.Key, Page);
+			Pending.Value.ExecuteIfBound(Page, NumMatches);
+		}
+	}));
+}
+
+void USaveManager::RequestThumbnail(FName SlotName, FOnThumbnailLoaded OnLoaded)
+{
+	if (SlotName.IsNone())
+	{
+		OnLoaded.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	// Requests of a slot being read wait for the same task
+	if (TArray<FOnThumbnailLoaded>* Pending = PendingThumbnails.Find(SlotName))
+	{
+		Pending->Add(MoveTemp(OnLoaded));
+		return;
+	}
+	PendingThumbnails.Add(SlotName).Add(MoveTemp(OnLoaded));
+
+	const FSEThumbnailCacheEntry* Cached = ThumbnailCache.FindByPredicate([SlotName](const FSEThumbnailCacheEntry& Entry) {
+		return Entry.SlotName == SlotName;
+	});
+	// Image wrappers can't be loaded from other threads
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	MTTasks.CreateTask<FLoadThumbnailTask>(SlotName, Cached ? Cached->TimeStamp : FDateTime::MinValue(), ImageWrapperModule)
+		.OnFinished([this](auto& Task) {
+			const FLoadThumbnailTask& Result = Task.GetTask();
+			const int32 CachedIndex = ThumbnailCache.IndexOfByPredicate([&Result](const FSEThumbnailCacheEntry& Entry) {
+				return Entry.SlotName == Result.SlotName;
+			});
+
+			UTexture2D* Texture = nullptr;
+			if (Result.bUnchanged && CachedIndex != INDEX_NONE)
+			{
+				Texture = ThumbnailCache[CachedIndex].Texture;
+			}
+			else
+			{
+				Texture = FSlotHelpers::CreateThumbnailTexture(Result.Width, Result.Height, Result.Pixels);
+			}
+
+			if (CachedIndex != INDEX_NONE)
+			{
+				ThumbnailCache.RemoveAt(CachedIndex);
+			}
+			const int32 MaxCached = GetDefault<USaveSettings>()->ThumbnailCacheSize;
+			if (Texture && MaxCached > 0)
+			{
+				// Most recently used last. The oldest are removed first
+				ThumbnailCache.Add({ Result.SlotName, Result.TimeStamp, Texture });
+				if (ThumbnailCache.Num() > MaxCached)
+				{
+					ThumbnailCache.RemoveAt(0, ThumbnailCache.Num() - MaxCached);
+				}
+			}
+
+			TArray<FOnThumbnailLoaded> Delegates;
+			PendingThumbnails.RemoveAndCopyValue(Result.SlotName, Delegates);
+			for (const FOnThumbnailLoaded& Delegate : Delegates)
+			{
+				Delegate.ExecuteIfBound(Texture);
+			}
+		})
+		.StartBackgroundTask();
+}
+
+UTexture2D* USaveManager::FindCachedThumbnail(FName SlotName) const
+{
+	const FSEThumbnailCacheEntry* Cached = ThumbnailCache.FindByPredicate([SlotName](const FSEThumbnailCacheEntry& Entry) {
+		return Entry.SlotName == SlotName;
+	});
+	return Cached ? Cached->Texture : nullptr;
+}
+
+bool USaveManager::GetSlotSummary(FName SlotName, FSlotSummary& Summary)
+{
+	if (SlotName.IsNone())
+	{
+		return false;
+	}
+
+	auto& Task = MTTasks.CreateTask<FLoadSlotSummariesTask>(this, SlotName)
+		.OnFinished([](auto& Task)
+		{
+			Task->AfterFinish();
+		});
+	Task.StartSynchronousTask();
+
+	check(Task.IsDone());
+
+	const auto& Summaries = Task->GetSummaries();
+	if (Summaries.Num() > 0)
+	{
+		Summary = Summaries[0];
+		return true;
+	}
+	return false;
+}
+
 void USaveManager::DeleteAllSlots(FOnSlotsDeleted Delegate)
 {
 	MTTasks.CreateTask<FDeleteSlotsTask>(this)
-		.OnFinished([Delegate](auto& Task) {
+		.OnFinished([this, Delegate](auto& Task) {
+			if (SlotIndex.IsBuilt())
+			{
+				SlotIndex.Build({});
+			}
+			ThumbnailCache.Empty();
 			Delegate.ExecuteIfBound();
 		})
 		.StartBackgroundTask();
 }
 
+bool USaveManager::CaptureSnapshot(bool bFlushToDisk, FOnGameSaved OnSaved)
+{
+	if (!CanLoadOrSave())
+		return false;
+
+	const USavePreset* Preset = GetPreset();
+	if (Preset->MaxSnapshots <= 0)
+	{
+		SELog(Preset, "Can't capture snapshots. MaxSnapshots is 0.", true);
+		return false;
+	}
+
+	TryInstantiateInfo();
+	const FName SlotName = CurrentInfo->FileName;
+	if (bFlushToDisk && SlotName.IsNone())
+	{
+		SELog(Preset, "Can't flush a snapshot to disk without a current slot.", true);
+		return false;
+	}
+
+	SELog(Preset, "Capturing Snapshot");
+
+	auto* Task = CreateTask<USlotDataTask_Saver>()
+		->SetupSnapshot(SlotName, bFlushToDisk)
+		->Bind(OnSaved)
+		->Start();
+
+	return Task->IsSucceeded() || Task->IsScheduled();
+}
+
+bool USaveManager::RestoreSnapshot(int32 Index, FOnGameLoaded OnLoaded)
+{
+	TSharedPtr<const FSaveFile> Snapshot = GetSnapshot(Index);
+	if (!CanLoadOrSave() || !Snapshot)
+	{
+		return false;
+	}
+
+	TryInstantiateInfo();
+
+	auto* Task = CreateTask<USlotDataTask_Loader>()
+		->SetupSnapshot(MoveTemp(Snapshot))
+		->Bind(OnLoaded)
+		->Start();
+
+	return Task->IsSucceeded() || Task->IsScheduled();
+}
+
+void USaveManager::__AddSnapshot(FSaveFile&& File)
+{
+	const int32 MaxSnapshots = GetPreset()->MaxSnapshots;
+	if (MaxSnapshots <= 0)
+	{
+		return;
+	}
+
+	// Tasks restoring an old snapshot keep it alive until they finish
+	if (Snapshots.Num() >= MaxSnapshots)
+	{
+		Snapshots.RemoveAt(0, Snapshots.Num() - MaxSnapshots + 1);
+	}
+	Snapshots.Add(MakeShared<FSaveFile>(MoveTemp(File)));
+}
+
 void USaveManager::BPSaveSlot(FName SlotName, bool bScreenshot, const FScreenshotSize Size,
 	ESaveGameResult& Result, struct FLatentActionInfo LatentInfo, bool bOverrideIfNeeded /*= true*/)
 {
@@ -203,6 +618,36 @@ void USaveManager::BPLoadAllSlotInfos(const bool bSortByRecent, TArray<USlotInfo
 	}
 }
 
+void USaveManager::BPLoadAllSlotSummaries(const bool bSortByRecent, TArray<FSlotSummary>& Summaries,
+	ELoadInfoResult& Result, struct FLatentActionInfo LatentInfo)
+{
+	if (UWorld* World = GetWorld())
+	{
+		FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+		if (LatentActionManager.FindExistingAction<FLoadSummariesAction>(
+				LatentInfo.CallbackTarget, LatentInfo.UUID) == nullptr)
+		{
+			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID,
+				new FLoadSummariesAction(this, bSortByRecent, Summaries, Result, LatentInfo));
+		}
+	}
+}
+
+void USaveManager::BPQuerySlots(FSlotQuery Query, TArray<FSlotSummary>& Page, int32& NumMatches,
+	ELoadInfoResult& Result, struct FLatentActionInfo LatentInfo)
+{
+	if (UWorld* World = GetWorld())
+	{
+		FLatentActionManager& LatentActionManager = World->GetLatentActionManager();
+		if (LatentActionManager.FindExistingAction<FQuerySlotsAction>(
+				LatentInfo.CallbackTarget, LatentInfo.UUID) == nullptr)
+		{
+			LatentActionManager.AddNewAction(LatentInfo.CallbackTarget, LatentInfo.UUID,
+				new FQuerySlotsAction(this, Query, Page, NumMatches, Result, LatentInfo));
+		}
+	}
+}
+
 void USaveManager::BPDeleteAllSlots(EDeleteSlotsResult& Result, struct FLatentActionInfo LatentInfo)
 {
 	if (UWorld* World = GetWorld())
@@ -312,6 +757,85 @@ void USaveManager::SerializeStreamingLevel(ULevelStreaming* LevelStreaming)
 	}
 }
 
+void USaveManager::TrimSubLevelRecords()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(USaveManager::TrimSubLevelRecords);
+
+	const USavePreset* Preset = GetPreset();
+	const UWorld* World = GetWorld();
+	if (!CurrentData || !World || Preset->SubLevelRecordsBudgetMB <= 0)
+	{
+		return;
+	}
+	const int64 BudgetBytes = int64(Preset->SubLevelRecordsBudgetMB) * 1024 * 1024;
+
+	// Records of visible levels will be replaced when they are hidden or saved
+	TSet<FName> VisibleLevels;
+	for (const ULevelStreaming* Level : World->GetStreamingLevels())
+	{
+		if (Level && Level->IsLevelVisible())
+		{
+			VisibleLevels.Add(Level->GetWorldAssetPackageFName());
+		}
+	}
+
+	int64 UsedBytes = 0;
+	TArray<FStreamingLevelRecord*> ColdLevels;
+	for (FStreamingLevelRecord& Level : CurrentData->SubLevels)
+	{
+		UsedBytes += Level.GetRecordsSize();
+		if (!Level.IsSpilled() && !VisibleLevels.Contains(Level.Name))
+		{
+			ColdLevels.Add(&Level);
+		}
+	}
+	if (UsedBytes <= BudgetBytes)
+	{
+		return;
+	}
+
+	// Least recently used first
+	ColdLevels.Sort([](const FStreamingLevelRecord& A, const FStreamingLevelRecord& B) {
+		return A.LastUsedCycles < B.LastUsedCycles;
+	});
+
+	if (!RecordSpillFile)
+	{
+		RecordSpillFile = MakeShared<FSERecordSpillFile, ESPMode::ThreadSafe>();
+	}
+	for (FStreamingLevelRecord* Level : ColdLevels)
+	{
+		if (UsedBytes <= BudgetBytes)
+		{
+			break;
+		}
+
+		const int64 Size = Level->GetRecordsSize();
+		if (Level->Spill(RecordSpillFile.ToSharedRef()))
+		{
+			UsedBytes -= Size;
+		}
+	}
+	SELog(Preset, FString::Printf(TEXT("Sub-level records use %lld KB after spilling to disk"), UsedBytes / 1024), FColor::White, false, 1);
+}
+
+void USaveManager::ScheduleSubLevelRecordsTrim()
+{
+	if (GetPreset()->SubLevelRecordsBudgetMB <= 0)
+	{
+		return;
+	}
+
+	// A trim waiting to start already covers all records
+	const bool bTrimWaiting = Tasks.ContainsByPredicate([](const USlotDataTask* Task) {
+		return Task->IsA<USlotDataTask_RecordsTrimmer>() && !Task->IsRunning() && !Task->IsFinished();
+	});
+	if (!bTrimWaiting)
+	{
+		CreateTask<USlotDataTask_RecordsTrimmer>()->Start();
+	}
+}
+
 void USaveManager::DeserializeStreamingLevel(ULevelStreaming* LevelStreaming)
 {
 	CreateTask<USlotDataTask_LevelLoader>()->Setup(LevelStreaming)->Start();
@@ -334,6 +858,7 @@ USlotInfo* USaveManager::LoadInfo(FName SlotName)
 
 	check(Task.IsDone());
 
+	Task->CreateInfos();
 	const auto& Infos = Task->GetLoadedSlots();
 	return Infos.Num() > 0? Infos[0] : nullptr;
 }
@@ -350,11 +875,99 @@ void USaveManager::FinishTask(USlotDataTask* Task)
 {
 	Tasks.Remove(Task);
 
-	// Start next task
-	if (Tasks.Num() > 0)
+	// Start tasks waiting for this one
+	StartReadyTasks();
+}
+
+USlotDataTask_Saver* USaveManager::FindPendingSave(FName SlotName) const
+{
+	for (int32 I = Tasks.Num() - 1; I >= 0; --I)
+	{
+		USlotDataTask* Task = Tasks[I];
+		if (Task->IsRunning() || Task->IsFinished())
+		{
+			// Only tasks after all running ones can be pending
+			break;
+		}
+
+		auto* Saver = Cast<USlotDataTask_Saver>(Task);
+		if (Saver && Saver->CanCoalesce() && Saver->GetSlotName() == SlotName)
+		{
+			return Saver;
+		}
+
+		if (!Task->GetAccess().IsEmpty())
+		{
+			break;
+		}
+	}
+	return nullptr;
+}
+
+bool USaveManager::CanStartTask(const USlotDataTask* Task) const
+{
+	const FSlotDataTaskAccess Access = Task->GetAccess();
+	for (const USlotDataTask* Other : Tasks)
+	{
+		if (Other == Task)
+		{
+			return true;
+		}
+
+		// Pending tasks also block later ones, so that conflicting tasks keep their order
+		if (!Other->IsFinished() && Other->GetAccess().ConflictsWith(Access))
+		{
+			return false;
+		}
+	}
+	// Not scheduled
+	return false;
+}
+
+bool USaveManager::FinishAllTasks()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(USaveManager::FinishAllTasks);
+
+	// The first task can always start. Finished tasks are removed
+	while (Tasks.Num() > 0)
 	{
-		Tasks[0]->Start();
+		USlotDataTask* Task = Tasks[0];
+		Task->Start();
+		Task->FinishNow();
+		if (Tasks.Num() > 0 && Tasks[0] == Task)
+		{
+			return false;
+		}
 	}
+	return true;
+}
+
+void USaveManager::StartReadyTasks()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(USaveManager::StartReadyTasks);
+
+	// Tasks can finish while starting. Iterate again instead of recursively
+	if (bStartingTasks)
+	{
+		bRestartReadyTasks = true;
+		return;
+	}
+
+	TGuardValue<bool> Guard(bStartingTasks, true);
+	do
+	{
+		bRestartReadyTasks = false;
+
+		const TArray<USlotDataTask*> PendingTasks = Tasks;
+		for (USlotDataTask* Task : PendingTasks)
+		{
+			if (!Task->IsRunning() && !Task->IsFinished() && Tasks.Contains(Task))
+			{
+				Task->Start();
+			}
+		}
+	}
+	while (bRestartReadyTasks);
 }
 
 FName USaveManager::GetSlotNameFromId(const int32 SlotId) const
@@ -370,19 +983,27 @@ FName USaveManager::GetSlotNameFromId(const int32 SlotId) const
 
 bool USaveManager::IsLoading() const
 {
-	return HasTasks() &&
-		   (Tasks[0]->IsA<USlotDataTask_Loader>() || Tasks[0]->IsA<USlotDataTask_LevelLoader>());
+	// Level loaders are also loaders
+	return Tasks.ContainsByPredicate([](const USlotDataTask* Task) {
+		return Task->IsRunning() && Task->IsA<USlotDataTask_Loader>();
+	});
 }
 
 void USaveManager::Tick(float DeltaTime)
 {
+	UpdateAutoSave(DeltaTime);
+
 	if (Tasks.Num())
 	{
-		USlotDataTask* Task = Tasks[0];
-		check(Task);
-		if (Task->IsRunning())
+		// Tasks can finish or start others while ticking
+		const TArray<USlotDataTask*> TickedTasks = Tasks;
+		for (USlotDataTask* Task : TickedTasks)
 		{
-			Task->Tick(DeltaTime);
+			check(Task);
+			if (Task->IsRunning())
+			{
+				Task->Tick(DeltaTime);
+			}
 		}
 	}
 
@@ -480,13 +1101,22 @@ void USaveManager::OnLoadFinished(const FSELevelFilter& Filter, const bool bErro
 void USaveManager::OnMapLoadStarted(const FString& MapName)
 {
 	SELog(GetPreset(), "Loading Map '" + MapName + "'", FColor::Purple);
+
+	// Pooled actors are destroyed with the world
+	ActorPool.Empty();
 }
 
 void USaveManager::OnMapLoadFinished(UWorld* LoadedWorld)
 {
-	if(auto* ActiveLoader = Cast<USlotDataTask_Loader>(Tasks.Num() ? Tasks[0] : nullptr))
+	// Only loaders waiting for the map react to it
+	const TArray<USlotDataTask*> RunningTasks = Tasks;
+	for (USlotDataTask* Task : RunningTasks)
 	{
-		ActiveLoader->OnMapLoaded();
+		auto* Loader = Cast<USlotDataTask_Loader>(Task);
+		if (Loader && Loader->IsRunning())
+		{
+			Loader->OnMapLoaded();
+		}
 	}
 
 	UpdateLevelStreamings();
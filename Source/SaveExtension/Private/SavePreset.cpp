@@ -27,6 +27,17 @@ void USavePreset::GetSlotNameFromId(int32 Id, FName& Name) const
 	}
 }
 
+void USavePreset::BPGetAutoSaveSlotName_Implementation(int32 Index, FName& Name) const
+{
+	// Call C++ inheritance chain by default
+	return GetAutoSaveSlotName(Index, Name);
+}
+
+void USavePreset::GetAutoSaveSlotName(int32 Index, FName& Name) const
+{
+	Name = FName{ FString::Printf(TEXT("AutoSave_%i"), Index) };
+}
+
 FSELevelFilter USavePreset::ToFilter() const
 {
 	FSELevelFilter Filter{};
@@ -1,8 +1,14 @@
 // Copyright 2015-2020 Piperift. All Rights Reserved.
 
 #include "Serialization/LevelRecords.h"
+#include "ISaveExtension.h"
+#include "Misc/RecordSpillFile.h"
 #include "SlotData.h"
 
+#include <Serialization/MemoryReader.h>
+#include <Serialization/MemoryWriter.h>
+#include <Serialization/ObjectAndNameAsStringProxyArchive.h>
+
 
 /////////////////////////////////////////////////////
 // LevelRecords
@@ -17,12 +23,20 @@ bool FLevelRecord::Serialize(FArchive& Ar)
 	Ar << bOverrideGeneralFilter;
 	if (bOverrideGeneralFilter)
 	{
+		if (Ar.IsLoading())
+		{
+			Filter = {};
+		}
 		static UScriptStruct* const LevelFilterType{ FSELevelFilter::StaticStruct() };
 		LevelFilterType->SerializeItem(Ar, &Filter, nullptr);
 	}
 
 	Ar << LevelScript;
-	Ar << Actors;
+	SERecords::SerializeArray(Ar, Actors);
+	if (Ar.IsLoading())
+	{
+		AssetReferences.Reset();
+	}
 
 	return true;
 }
@@ -30,5 +44,189 @@ bool FLevelRecord::Serialize(FArchive& Ar)
 void FLevelRecord::CleanRecords()
 {
 	LevelScript = {};
-	Actors.Empty();
+	// Capacity is kept for the next save or load
+	Actors.Reset();
+	AssetReferences.Reset();
+}
+
+bool FStreamingLevelRecord::Serialize(FArchive& Ar)
+{
+	if (Ar.IsLoading())
+	{
+		ResetEncoded();
+	}
+	else
+	{
+		Decode();
+	}
+	return Super::Serialize(Ar);
+}
+
+void FStreamingLevelRecord::SerializeLazy(FArchive& Ar)
+{
+	Ar << Name;
+	if (Ar.IsLoading())
+	{
+		// The rest of the level is only known once decoded
+		CleanRecords();
+		bOverrideGeneralFilter = false;
+		Filter = {};
+		SERecords::SerializeArray(Ar, EncodedBytes);
+	}
+	else if (IsSpilled())
+	{
+		// Read back only to be written
+		TArray<uint8> Bytes;
+		ReadEncoded(Bytes);
+		Ar << Bytes;
+	}
+	else if (IsEncoded())
+	{
+		// Never decoded since it was loaded. Written as it was read
+		Ar << EncodedBytes;
+	}
+	else
+	{
+		TArray<uint8> Bytes;
+		Encode(Bytes);
+		Ar << Bytes;
+	}
+}
+
+void FStreamingLevelRecord::Decode()
+{
+	if (!IsEncoded())
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FStreamingLevelRecord::Decode);
+	TArray<uint8> Bytes;
+	const bool bRead = ReadEncoded(Bytes);
+	ResetEncoded();
+	if (!bRead)
+	{
+		UE_LOG(LogSaveExtension, Warning, TEXT("Failed to read back records of level '%s'"), *Name.ToString());
+		return;
+	}
+
+	FMemoryReader Reader{ Bytes };
+	FObjectAndNameAsStringProxyArchive LevelAr(Reader, true);
+	Super::Serialize(LevelAr);
+}
+
+bool FStreamingLevelRecord::SetEncoded(TArray<uint8>&& Bytes)
+{
+	FName EncodedName;
+	{
+		FMemoryReader Reader{ Bytes };
+		FObjectAndNameAsStringProxyArchive LevelAr(Reader, true);
+		LevelAr << EncodedName;
+		if (LevelAr.IsError())
+		{
+			return false;
+		}
+	}
+
+	// The rest of the level is only known once decoded
+	CleanRecords();
+	bOverrideGeneralFilter = false;
+	Filter = {};
+	Name = EncodedName;
+	EncodedBytes = MoveTemp(Bytes);
+	return true;
+}
+
+bool FStreamingLevelRecord::ReadEncoded(TArray<uint8>& OutBytes) const
+{
+	if (IsSpilled())
+	{
+		return SpillRange->Read(OutBytes);
+	}
+	OutBytes = EncodedBytes;
+	return OutBytes.Num() > 0;
+}
+
+bool FStreamingLevelRecord::Spill(const TSharedRef<FSERecordSpillFile, ESPMode::ThreadSafe>& File)
+{
+	if (IsSpilled())
+	{
+		return true;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FStreamingLevelRecord::Spill);
+	const bool bWasDecoded = EncodedBytes.Num() <= 0;
+	if (bWasDecoded)
+	{
+		Encode(EncodedBytes);
+	}
+
+	const int32 Size = EncodedBytes.Num();
+	const int64 Offset = File->Append(MoveTemp(EncodedBytes));
+	if (Offset == INDEX_NONE)
+	{
+		if (bWasDecoded)
+		{
+			// Decoded records are still valid
+			EncodedBytes.Empty();
+		}
+		return false;
+	}
+
+	// Decoded records are released too. They are read back from the file when needed
+	CleanRecords();
+	EncodedBytes.Empty();
+	SpillRange = MakeShared<const FSERecordSpillRange, ESPMode::ThreadSafe>(File, Offset, Size);
+	return true;
+}
+
+int64 FStreamingLevelRecord::GetRecordsSize() const
+{
+	if (IsSpilled())
+	{
+		return 0;
+	}
+	if (RecordsSize != INDEX_NONE)
+	{
+		return RecordsSize;
+	}
+
+	const auto GetObjectSize = [](const FObjectRecord& Record) {
+		return int64(Record.Data.GetAllocatedSize()) + Record.Tags.GetAllocatedSize();
+	};
+
+	int64 Size = EncodedBytes.GetAllocatedSize() + GetObjectSize(LevelScript) + Actors.GetAllocatedSize();
+	for (const FActorRecord& Actor : Actors)
+	{
+		Size += GetObjectSize(Actor) + Actor.ComponentRecords.GetAllocatedSize();
+		for (const FComponentRecord& Component : Actor.ComponentRecords)
+		{
+			Size += GetObjectSize(Component);
+		}
+	}
+	RecordsSize = Size;
+	return Size;
+}
+
+void FStreamingLevelRecord::CleanRecords()
+{
+	Super::CleanRecords();
+	ResetEncoded();
+}
+
+void FStreamingLevelRecord::Encode(TArray<uint8>& OutBytes)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FStreamingLevelRecord::Encode);
+	OutBytes.Reset();
+	FMemoryWriter Writer{ OutBytes };
+	FObjectAndNameAsStringProxyArchive LevelAr(Writer, false);
+	Super::Serialize(LevelAr);
+}
+
+void FStreamingLevelRecord::ResetEncoded()
+{
+	EncodedBytes.Reset();
+	// Its space in the file is reused once no copy of the record refers to it
+	SpillRange.Reset();
+	MarkRecordsChanged();
 }
@@ -28,8 +28,57 @@ void FMTTask_SerializeActors::DoWork()
 		{
 			FActorRecord& Record = ActorRecords.AddDefaulted_GetRef();
 			SerializeActor(Actor, Record);
+
+			if (Stream && ActorRecords.Num() >= ActorsPerChunk)
+			{
+				EncodeChunk();
+			}
+		}
+	}
+
+	if (Stream)
+	{
+		EncodeChunk();
+	}
+}
+
+void FMTTask_SerializeActors::EncodeChunk()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FMTTask_SerializeActors::EncodeChunk);
+	if (ActorRecords.Num() <= 0)
+	{
+		return;
+	}
+
+	// Classes can't be found from the records later, since they are not kept
+	for (const FActorRecord& Record : ActorRecords)
+	{
+		if (Record.Class && !Record.Class->HasAnyClassFlags(CLASS_Native))
+		{
+			AssetReferences.Add(FSoftObjectPath{ Record.Class });
+		}
+		for (const FComponentRecord& Component : Record.ComponentRecords)
+		{
+			if (Component.Class && !Component.Class->HasAnyClassFlags(CLASS_Native))
+			{
+				AssetReferences.Add(FSoftObjectPath{ Component.Class });
+			}
 		}
 	}
+
+	TArray<uint8> Chunk = FSaveFileStream::EncodeChunk(ESERecordChunk::Actors, LevelIndex, Stream->IsCompressed(), [this](FArchive& Ar) {
+		Ar << ActorRecords;
+	});
+	// Capacity is reused for the next chunk
+	ActorRecords.Reset();
+
+	if (LastChunkWrite)
+	{
+		// Chunks are not encoded faster than they can be written
+		TRACE_CPUPROFILER_EVENT_SCOPE(WaitForWrite);
+		FTaskGraphInterface::Get().WaitUntilTaskCompletes(LastChunkWrite);
+	}
+	LastChunkWrite = Stream->AppendChunk(MoveTemp(Chunk));
 }
 
 void FMTTask_SerializeActors::SerializeGameInstance()
@@ -41,14 +90,14 @@ void FMTTask_SerializeActors::SerializeGameInstance()
 
 		//Serialize into Record Data
 		FMemoryWriter MemoryWriter(Record.Data, true);
-		FSEArchive Archive(MemoryWriter, false);
+		FSEArchive Archive(MemoryWriter, false, &AssetReferences);
 		GameInstance->Serialize(Archive);
 
 		SlotData->GameInstance = MoveTemp(Record);
 	}
 }
 
-bool FMTTask_SerializeActors::SerializeActor(const AActor* Actor, FActorRecord& Record) const
+bool FMTTask_SerializeActors::SerializeActor(const AActor* Actor, FActorRecord& Record)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FMTTask_SerializeActors::SerializeActor);
 
@@ -103,13 +152,13 @@ bool FMTTask_SerializeActors::SerializeActor(const AActor* Actor, FActorRecord&
 
 	TRACE_CPUPROFILER_EVENT_SCOPE(Serialize);
 	FMemoryWriter MemoryWriter(Record.Data, true);
-	FSEArchive Archive(MemoryWriter, false);
+	FSEArchive Archive(MemoryWriter, false, &AssetReferences);
 	const_cast<AActor*>(Actor)->Serialize(Archive);
 
 	return true;
 }
 
-void FMTTask_SerializeActors::SerializeActorComponents(const AActor* Actor, FActorRecord& ActorRecord, int8 Indent /*= 0*/) const
+void FMTTask_SerializeActors::SerializeActorComponents(const AActor* Actor, FActorRecord& ActorRecord, int8 Indent /*= 0*/)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(FMTTask_SerializeActors::SerializeActorComponents);
 
@@ -140,7 +189,7 @@ void FMTTask_SerializeActors::SerializeActorComponents(const AActor* Actor, FAct
 			if (!Component->GetClass()->IsChildOf<UPrimitiveComponent>())
 			{
 				FMemoryWriter MemoryWriter(ComponentRecord.Data, true);
-				FSEArchive Archive(MemoryWriter, false);
+				FSEArchive Archive(MemoryWriter, false, &AssetReferences);
 				Component->Serialize(Archive);
 			}
 			ActorRecord.ComponentRecords.Add(ComponentRecord);
@@ -34,8 +34,14 @@ bool FObjectRecord::Serialize(FArchive& Ar)
 
 	if (Class)
 	{
-		Ar << Data;
-		Ar << Tags;
+		SERecords::SerializeArray(Ar, Data);
+		SERecords::SerializeArray(Ar, Tags);
+	}
+	else if (Ar.IsLoading())
+	{
+		// Records can be reused. Clear what was not loaded
+		Data.Reset();
+		Tags.Reset();
 	}
 	return true;
 }
@@ -47,6 +53,10 @@ bool FComponentRecord::Serialize(FArchive& Ar)
 	{
 		Ar << Transform;
 	}
+	else if (Ar.IsLoading())
+	{
+		Transform = FTransform::Identity;
+	}
 	return true;
 }
 
@@ -55,6 +65,10 @@ bool FActorRecord::Serialize(FArchive& Ar)
 	Super::Serialize(Ar);
 	if (!Class)
 	{
+		if (Ar.IsLoading())
+		{
+			ComponentRecords.Reset();
+		}
 		return true;
 	}
 
@@ -71,6 +85,11 @@ bool FActorRecord::Serialize(FArchive& Ar)
 		Ar << LinearVelocity;
 		Ar << AngularVelocity;
 	}
-	Ar << ComponentRecords;
+	else if (Ar.IsLoading())
+	{
+		LinearVelocity = FVector::ZeroVector;
+		AngularVelocity = FVector::ZeroVector;
+	}
+	SERecords::SerializeArray(Ar, ComponentRecords);
 	return true;
 }
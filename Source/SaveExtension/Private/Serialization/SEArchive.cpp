@@ -48,6 +48,12 @@ FArchive& FSEArchive::operator<<(UObject*& Obj)
 			FString SavedString{ Obj->GetPathName() };
 			InnerArchive << SavedString;
 
+			// Classes and assets can be loaded before deserializing
+			if (ReferencedAssets && (Obj->IsAsset() || Obj->IsA<UClass>()))
+			{
+				ReferencedAssets->Add(FSoftObjectPath{ SavedString });
+			}
+
 			/*bool bIsLocallyOwned = IsObjectOwned(Obj);
 			InnerArchive << bIsLocallyOwned;
 			if (bIsLocallyOwned)
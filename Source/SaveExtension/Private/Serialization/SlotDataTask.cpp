@@ -13,8 +13,8 @@ USlotDataTask* USlotDataTask::Start()
 {
 	const USaveManager* Manager = GetManager();
 
-	// If not running and first task is this
-	if (!bRunning && Manager->Tasks.Num() > 0 && Manager->Tasks[0] == this)
+	// If not running and no previous task conflicts with this one
+	if (!bRunning && !bFinished && Manager->CanStartTask(this))
 	{
 		bRunning = true;
 		OnStart();
@@ -28,12 +28,28 @@ void USlotDataTask::Finish(bool bSuccess)
 	{
 		OnFinish(bSuccess);
 		MarkAsGarbage();
-		GetManager()->FinishTask(this);
+		bRunning = false;
 		bFinished = true;
 		bSucceeded = bSuccess;
+		GetManager()->FinishTask(this);
 	}
 }
 
+bool USlotDataTask::Cancel()
+{
+	if (bRunning || bFinished)
+	{
+		return false;
+	}
+
+	OnCancel();
+	MarkAsGarbage();
+	bFinished = true;
+	bSucceeded = false;
+	GetManager()->FinishTask(this);
+	return true;
+}
+
 bool USlotDataTask::IsScheduled() const
 {
 	return GetManager()->Tasks.Contains(this);
@@ -44,6 +60,11 @@ USaveManager* USlotDataTask::GetManager() const
 	return Cast<USaveManager>(GetOuter());
 }
 
+void USlotDataTask::OnAccessReduced()
+{
+	GetManager()->StartReadyTasks();
+}
+
 void USlotDataTask::BakeAllFilters()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask::BakeAllFilters);
@@ -82,8 +103,25 @@ FLevelRecord* USlotDataTask::FindLevelRecord(const ULevelStreaming* Level) const
 {
 	if (!Level)
 		return &SlotData->MainLevel;
-	else // Find the Sub-Level
-		return SlotData->SubLevels.FindByKey(Level);
+
+	// Find the Sub-Level
+	FStreamingLevelRecord* Record = SlotData->SubLevels.FindByKey(Level);
+	if (Record)
+	{
+		// Records found here can be written
+		Record->LastUsedCycles = FPlatformTime::Cycles64();
+		Record->MarkRecordsChanged();
+	}
+	if (Record && Record->IsEncoded())
+	{
+		// Sub-levels are decoded once needed, after filters were baked
+		Record->Decode();
+		if (Record->bOverrideGeneralFilter)
+		{
+			Record->Filter.BakeAllowedClasses();
+		}
+	}
+	return Record;
 }
 
 UWorld* USlotDataTask::GetWorld() const
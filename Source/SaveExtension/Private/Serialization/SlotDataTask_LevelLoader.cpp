@@ -21,6 +21,7 @@ void USlotDataTask_LevelLoader::OnStart()
 
 		if (Preset->IsFrameSplitLoad())
 		{
+			LoadState = ELoadDataTaskState::Deserializing;
 			DeserializeLevelASync(StreamingLevel->GetLoadedLevel(), StreamingLevel);
 		}
 		else
@@ -33,6 +34,32 @@ void USlotDataTask_LevelLoader::OnStart()
 	Finish(false);
 }
 
+void USlotDataTask_LevelLoader::FinishNow()
+{
+	// The rest of the level is restored at once
+	MaxFrameMs = TNumericLimits<float>::Max();
+	while (IsRunning())
+	{
+		if (!CurrentLevel.IsValid())
+		{
+			Finish(false);
+			return;
+		}
+		DeserializeASyncLoop();
+	}
+}
+
+void USlotDataTask_LevelLoader::GetViewLocations(TArray<FVector>& OutLocations)
+{
+	for (auto It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* Controller = It->Get())
+		{
+			GetCurrentViewLocation(Controller, OutLocations);
+		}
+	}
+}
+
 void USlotDataTask_LevelLoader::DeserializeASyncLoop(float StartMS /*= 0.0f*/)
 {
 	FLevelRecord& LevelRecord = *FindLevelRecord(CurrentSLevel.Get());
@@ -45,9 +72,9 @@ void USlotDataTask_LevelLoader::DeserializeASyncLoop(float StartMS /*= 0.0f*/)
 	const auto& Filter = GetLevelFilter(LevelRecord);
 
 	// Continue Iterating actors every tick
-	for (; CurrentActorIndex < CurrentLevelActors.Num(); ++CurrentActorIndex)
+	AActor* Actor = nullptr;
+	while (PopNextAsyncActor(Actor))
 	{
-		AActor* Actor{ CurrentLevelActors[CurrentActorIndex].Get() };
 		if (Actor)
 		{
 			DeserializeLevel_Actor(Actor, LevelRecord, Filter);
@@ -55,7 +82,10 @@ void USlotDataTask_LevelLoader::DeserializeASyncLoop(float StartMS /*= 0.0f*/)
 			const float CurrentMS = GetTimeMilliseconds();
 			// If x milliseconds passed, continue on next frame
 			if (CurrentMS - StartMS >= MaxFrameMs)
+			{
+				FlushMovementUpdates();
 				return;
+			}
 		}
 	}
 
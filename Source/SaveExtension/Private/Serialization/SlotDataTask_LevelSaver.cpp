@@ -24,6 +24,9 @@ void USlotDataTask_LevelSaver::OnStart()
 
 		RunScheduledTasks();
 
+		// Hidden levels may not be shown again soon
+		GetManager()->ScheduleSubLevelRecordsTrim();
+
 		Finish(true);
 		return;
 	}
@@ -6,6 +6,8 @@
 #include <Serialization/MemoryReader.h>
 #include <Kismet/GameplayStatics.h>
 #include <Components/PrimitiveComponent.h>
+#include <Engine/LevelBounds.h>
+#include <GameFramework/PlayerController.h>
 #include <UObject/UObjectGlobals.h>
 
 #include "Misc/SlotHelpers.h"
@@ -19,23 +21,129 @@
 
 namespace Loader
 {
-	static int32 RemoveSingleRecordPtrSwap(TArray<FActorRecord*>& Records, AActor* Actor, bool bAllowShrinking = true)
+	/** Records indexed between time checks on frame split loads */
+	static constexpr int32 IndexBatchSize = 100;
+
+	/** Indexes actor records by name. Records match actors of the same name and class */
+	static void IndexRecords(const FLevelRecord& LevelRecord, int32 StartIndex, int32 Num, FActorRecordIndex& OutIndex)
+	{
+		OutIndex.Reserve(OutIndex.Num() + Num);
+		for (int32 I = StartIndex; I < StartIndex + Num; ++I)
+		{
+			OutIndex.Add(LevelRecord.Actors[I].Name, I);
+		}
+	}
+
+	/** Records respawned between time checks on frame split loads */
+	static constexpr int32 RespawnBatchSize = 8;
+
+	/**
+	 * Finds the record of a component.
+	 * Components are iterated in the same order they were saved, so the next record in order is tried first.
+	 * A name index is only built the first time records don't match sequentially.
+	 */
+	static const FComponentRecord* FindComponentRecord(const TArray<FComponentRecord>& Records,
+		const UActorComponent* Component, int32& NextIndex, TMap<FName, int32>& RecordIndices)
 	{
-		if(!Actor)
+		if (Records.IsValidIndex(NextIndex) && Records[NextIndex] == Component)
+		{
+			return &Records[NextIndex++];
+		}
+
+		if (RecordIndices.Num() <= 0)
 		{
-			return 0;
+			RecordIndices.Reserve(Records.Num());
+			for (int32 I = 0; I < Records.Num(); ++I)
+			{
+				RecordIndices.Add(Records[I].Name, I);
+			}
 		}
 
-		const int32 I = Records.IndexOfByPredicate([Records, Actor](auto* Record)
+		if (const int32* const Index = RecordIndices.Find(Component->GetFName()))
 		{
-			return *Record == Actor;
-		});
-		if (I != INDEX_NONE)
+			const FComponentRecord& Record = Records[*Index];
+			if (Record == Component)
+			{
+				NextIndex = *Index + 1;
+				return &Record;
+			}
+		}
+		return nullptr;
+	}
+
+	static float GetDistanceSquared(const TArray<FVector>& Locations, const FVector& Point)
+	{
+		float Distance = TNumericLimits<float>::Max();
+		for (const FVector& Location : Locations)
 		{
-			Records.RemoveAtSwap(I, 1, bAllowShrinking);
-			return 1;
+			Distance = FMath::Min(Distance, float(FVector::DistSquared(Location, Point)));
+		}
+		return Distance;
+	}
+
+	static float GetDistanceSquared(const TArray<FVector>& Locations, const FBox& Box)
+	{
+		float Distance = TNumericLimits<float>::Max();
+		if (Box.IsValid)
+		{
+			for (const FVector& Location : Locations)
+			{
+				Distance = FMath::Min(Distance, float(Box.ComputeSquaredDistanceToPoint(Location)));
+			}
+		}
+		return Distance;
+	}
+
+	/** @return how many parents an actor is attached under. OutRoot is the top parent */
+	static int32 GetAttachmentDepth(const AActor* Actor, const AActor*& OutRoot)
+	{
+		int32 Depth = 0;
+		OutRoot = Actor;
+		while (const AActor* Parent = OutRoot ? OutRoot->GetAttachParentActor() : nullptr)
+		{
+			OutRoot = Parent;
+			++Depth;
+		}
+		return Depth;
+	}
+
+	static const AActor* ToActor(const AActor* Actor) { return Actor; }
+	static const AActor* ToActor(const TWeakObjectPtr<AActor>& Actor) { return Actor.Get(); }
+
+	/**
+	 * Moves attached actors after their parents, sorted by attachment depth.
+	 * Otherwise an attached actor would be placed relative to the previous transform of its parent.
+	 */
+	template<typename T>
+	static void SortParentsFirst(TArray<T>& Actors)
+	{
+		TArray<TPair<int32, T>> AttachedActors;
+		int32 NumRoots = 0;
+		for (int32 I = 0; I < Actors.Num(); ++I)
+		{
+			const AActor* Root = nullptr;
+			const int32 Depth = GetAttachmentDepth(ToActor(Actors[I]), Root);
+			if (Depth > 0)
+			{
+				AttachedActors.Emplace(Depth, Actors[I]);
+			}
+			else
+			{
+				Actors[NumRoots++] = Actors[I];
+			}
+		}
+
+		if (AttachedActors.Num() > 0)
+		{
+			Actors.SetNum(NumRoots, false);
+			AttachedActors.StableSort([](const TPair<int32, T>& A, const TPair<int32, T>& B) {
+				return A.Key < B.Key;
+			});
+			for (const auto& Attached : AttachedActors)
+			{
+				Actors.Add(Attached.Value);
+			}
 		}
-		return 0;
 	}
 }
 
@@ -48,19 +156,62 @@ void USlotDataTask_Loader::OnStart()
 	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Loader::OnStart);
 	USaveManager* Manager = GetManager();
 
-	SELog(Preset, "Loading from Slot " + SlotName.ToString());
+	if (Snapshot)
+	{
+		SELog(Preset, "Loading from Snapshot");
+		NewSlotInfo = Snapshot->CreateAndDeserializeInfo(Manager);
+		SlotName = NewSlotInfo ? NewSlotInfo->FileName : NAME_None;
 
-	NewSlotInfo = Manager->LoadInfo(SlotName);
-	if (!NewSlotInfo)
+		if (!NewSlotInfo)
+		{
+			SELog(Preset, "Slot Info not found! Can't load.", FColor::White, true, 1);
+			Finish(false);
+			return;
+		}
+	}
+	else
 	{
-		SELog(Preset, "Slot Info not found! Can't load.", FColor::White, true, 1);
-		Finish(false);
-		return;
+		SELog(Preset, "Loading from Slot " + SlotName.ToString());
 	}
 
-	// We load data while the map opens or GC runs
+	// We load data while the map opens or GC runs.
+	// The info of a slot comes from the header of the same read, so the disk is not touched here
 	StartLoadingData();
 
+	if (NewSlotInfo)
+	{
+		OnInfoRead();
+	}
+	else
+	{
+		LoadState = ELoadDataTaskState::ReadingHeader;
+		UpdateReadingHeader();
+	}
+}
+
+void USlotDataTask_Loader::UpdateReadingHeader()
+{
+	const FLoadFileTask& Task = LoadDataTask->GetTask();
+	if (Task.IsHeaderRead())
+	{
+		NewSlotInfo = Task.GetHeader().CreateAndDeserializeInfo(GetManager());
+		if (!NewSlotInfo)
+		{
+			SELog(Preset, "Slot Info not found! Can't load.", FColor::White, true, 1);
+			Finish(false);
+			return;
+		}
+		OnInfoRead();
+	}
+	else if (LoadDataTask->IsDone())
+	{
+		SELog(Preset, "Slot '" + SlotName.ToString() + "' not found! Can't load.", FColor::White, true, 1);
+		Finish(false);
+	}
+}
+
+void USlotDataTask_Loader::OnInfoRead()
+{
 	const UWorld* World = GetWorld();
 
 	// Cross-Level loading
@@ -97,14 +248,26 @@ void USlotDataTask_Loader::Tick(float DeltaTime)
 	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Loader::Tick);
 	switch(LoadState)
 	{
+	case ELoadDataTaskState::RestoringActors:
+		PrepareASyncLoop();
+		break;
+
 	case ELoadDataTaskState::Deserializing:
-		if (CurrentLevel.IsValid())
-		{
-			DeserializeASyncLoop();
-		}
+		// Actors of a level unloaded meanwhile are skipped and the next level continues
+		DeserializeASyncLoop();
+		break;
+
+	case ELoadDataTaskState::ReadingHeader:
+		UpdateLoadingData();
+		UpdateReadingHeader();
+		break;
+
+	case ELoadDataTaskState::LoadingMap:
+		UpdateLoadingData();
 		break;
 
 	case ELoadDataTaskState::WaitingForData:
+		UpdateLoadingData();
 		if (IsDataLoaded())
 		{
 			StartDeserialization();
@@ -118,8 +281,21 @@ void USlotDataTask_Loader::OnFinish(bool bSuccess)
 	if (bSuccess)
 	{
 		SELog(Preset, "Finished Loading", FColor::Green);
+
+		// Sub-levels not shown by the loaded map can be moved to disk
+		GetManager()->ScheduleSubLevelRecordsTrim();
+	}
+
+	// Loaded references are kept by the world from now on
+	if (PreloadHandle)
+	{
+		PreloadHandle->ReleaseHandle();
+		PreloadHandle.Reset();
 	}
 
+	// Pooled actors not reused by this load would be the ones destroyed without a pool
+	GetManager()->GetActorPool().DestroyAll();
+
 	// Execute delegates
 	Delegate.ExecuteIfBound((bSuccess) ? NewSlotInfo : nullptr);
 
@@ -137,6 +313,12 @@ void USlotDataTask_Loader::BeginDestroy()
 		delete LoadDataTask;
 	}
 
+	if (PreloadHandle)
+	{
+		PreloadHandle->CancelHandle();
+		PreloadHandle.Reset();
+	}
+
 	Super::BeginDestroy();
 }
 
@@ -152,10 +334,12 @@ void USlotDataTask_Loader::OnMapLoaded()
 	{
 		UE_LOG(LogSaveExtension, Warning, TEXT("Failed loading map from saved slot."));
 		Finish(false);
+		return;
 	}
 	const FName NewMapName { FSlotHelpers::GetWorldName(World) };
 	if (NewMapName == NewSlotInfo->Map)
 	{
+		UpdateLoadingData();
 		if(IsDataLoaded())
 		{
 			StartDeserialization();
@@ -172,6 +356,7 @@ void USlotDataTask_Loader::StartDeserialization()
 	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Loader::StartDeserialization);
 	check(NewSlotInfo);
 
+	const float StartMS = GetTimeMilliseconds();
 	LoadState = ELoadDataTaskState::Deserializing;
 
 	SlotData = GetLoadedData();
@@ -189,23 +374,92 @@ void USlotDataTask_Loader::StartDeserialization()
 	GetManager()->__SetCurrentInfo(NewSlotInfo);
 
 	BakeAllFilters();
+	if (Preset->bUseActorPool)
+	{
+		Preset->PooledActorFilter.BakeAllowedClasses();
+	}
 
 	BeforeDeserialize();
 
 	if (Preset->IsFrameSplitLoad())
-		DeserializeASync();
+		DeserializeASync(StartMS);
 	else
 		DeserializeSync();
 }
 
 void USlotDataTask_Loader::StartLoadingData()
 {
-	LoadDataTask = new FAsyncTask<FLoadFileTask>(GetManager(), SlotName.ToString());
+	if (Snapshot)
+	{
+		// Snapshots are already in memory and their references were loaded when captured
+		bDeserializingData = true;
+		LoadDataTask = new FAsyncTask<FLoadFileTask>(GetManager(), Snapshot);
+	}
+	else
+	{
+		// When preloading, the data is deserialized by a second task once its references are loaded
+		bDeserializingData = !Preset->bPreloadReferences;
+		LoadDataTask = new FAsyncTask<FLoadFileTask>(GetManager(), SlotName.ToString(), !bDeserializingData);
+	}
+
+	if (bDeserializingData && Preset->bReuseSlotData)
+	{
+		LoadDataTask->GetTask().SetReusedData(GetManager()->GetCurrentData());
+	}
+	LoadDataTask->GetTask().SetValidateRecords(bDeserializingData && Preset->IsMTSerializationLoad());
 
 	if (Preset->IsMTFilesLoad())
 		LoadDataTask->StartBackgroundTask();
 	else
 		LoadDataTask->StartSynchronousTask();
+
+	UpdateLoadingData();
+}
+
+void USlotDataTask_Loader::UpdateLoadingData()
+{
+	if (!LoadDataTask || bDeserializingData)
+	{
+		return;
+	}
+
+	FLoadFileTask& Task = LoadDataTask->GetTask();
+	if (!bPreloadRequested && Task.IsHeaderRead())
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Loader::RequestPreload);
+		bPreloadRequested = true;
+
+		TArray<FSoftObjectPath> References = Task.GetReferences();
+		if (References.Num() > 0)
+		{
+			SELog(Preset, "Preloading " + FString::FromInt(References.Num()) + " classes and assets", FColor::White, false, 1);
+			PreloadHandle = GetManager()->GetStreamableManager().RequestAsyncLoad(
+				MoveTemp(References), FStreamableDelegate{}, FStreamableManager::AsyncLoadHighPriority);
+		}
+	}
+
+	if (!LoadDataTask->IsDone() || !Task.IsHeaderRead() || (PreloadHandle && PreloadHandle->IsLoadingInProgress()))
+	{
+		// A file that couldn't be read is reported by UpdateReadingHeader
+		return;
+	}
+
+	// File is read and its references loaded. Deserialize its data
+	FAsyncTask<FLoadFileTask>* const ReadTask = LoadDataTask;
+	LoadDataTask = new FAsyncTask<FLoadFileTask>(GetManager(), Task.GetSharedFile());
+	delete ReadTask;
+
+	if (Preset->bReuseSlotData)
+	{
+		LoadDataTask->GetTask().SetReusedData(GetManager()->GetCurrentData());
+	}
+	LoadDataTask->GetTask().SetValidateRecords(Preset->IsMTSerializationLoad());
+
+	bDeserializingData = true;
+	if (Preset->IsMTFilesLoad())
+		LoadDataTask->StartBackgroundTask();
+	else
+		LoadDataTask->StartSynchronousTask();
 }
 
 USlotData* USlotDataTask_Loader::GetLoadedData() const
@@ -273,29 +527,86 @@ void USlotDataTask_Loader::DeserializeLevelSync(const ULevel* Level, const ULeve
 	{
 		const auto& Filter = GetLevelFilter(*LevelRecord);
 
+		TArray<AActor*> Actors;
+		Actors.Reserve(Level->Actors.Num());
 		for (auto ActorItr = Level->Actors.CreateConstIterator(); ActorItr; ++ActorItr)
 		{
 			auto* Actor = *ActorItr;
 			if (IsValid(Actor) && Filter.ShouldSave(Actor))
 			{
-				DeserializeLevel_Actor(Actor, *LevelRecord, Filter);
+				Actors.Add(Actor);
 			}
 		}
+		Loader::SortParentsFirst(Actors);
+
+		for (AActor* Actor : Actors)
+		{
+			DeserializeLevel_Actor(Actor, *LevelRecord, Filter);
+		}
+
+		// Propagate transforms and update overlaps once for the whole level
+		FlushMovementUpdates();
 	}
 }
 
-void USlotDataTask_Loader::DeserializeASync()
+void USlotDataTask_Loader::DeserializeASync(float StartMS)
 {
-	// Deserialize world
+	SELog(Preset, "World '" + GetWorld()->GetName() + "'", FColor::Green, false, 1);
+
+	// Levels are prepared before being deserialized, continuing every frame
+	LoadState = ELoadDataTaskState::RestoringActors;
+	CurrentLevel = GetWorld()->GetCurrentLevel();
+	CurrentSLevel = nullptr;
+	PrepareStep = EPrepareLevelStep::None;
+	QueueAsyncLevels();
+	PrepareASyncLoop(StartMS);
+}
+
+void USlotDataTask_Loader::PrepareASyncLoop(float StartMS)
+{
+	if (StartMS <= 0)
 	{
-		SELog(Preset, "World '" + GetWorld()->GetName() + "'", FColor::Green, false, 1);
+		StartMS = GetTimeMilliseconds();
+	}
 
-		PrepareAllLevels();
-		DeserializeLevelASync(GetWorld()->GetCurrentLevel());
+	while (true)
+	{
+		ULevelStreaming* LevelStreaming = CurrentSLevel.Get();
+		const ULevel* Level = CurrentLevel.Get();
+		if (!Level)
+		{
+			// Unloaded while being prepared. Its progress is dropped and the next level continues
+			PrepareStep = EPrepareLevelStep::None;
+			CurrentLevelActors.Empty();
+			ActorsToSpawn.Empty();
+			FoundRecords.Empty();
+		}
+		else if (FLevelRecord* LevelRecord = FindLevelRecord(LevelStreaming))
+		{
+			if (!PrepareLevel(Level, *LevelRecord, true, StartMS))
+			{
+				// Out of time, continue on next frame
+				return;
+			}
+		}
+
+		FindNextAsyncLevel(LevelStreaming);
+		if (!LevelStreaming)
+		{
+			break;
+		}
+		// Prepare next level
+		CurrentLevel = LevelStreaming->GetLoadedLevel();
+		CurrentSLevel = LevelStreaming;
 	}
+
+	// All levels prepared, deserialize them starting with the main level
+	LoadState = ELoadDataTaskState::Deserializing;
+	QueueAsyncLevels();
+	DeserializeLevelASync(GetWorld()->GetCurrentLevel(), nullptr, StartMS);
 }
 
-void USlotDataTask_Loader::DeserializeLevelASync(ULevel* Level, ULevelStreaming* StreamingLevel)
+void USlotDataTask_Loader::DeserializeLevelASync(ULevel* Level, ULevelStreaming* StreamingLevel, float StartMS)
 {
 	check(IsValid(Level));
 
@@ -308,20 +619,59 @@ void USlotDataTask_Loader::DeserializeLevelASync(ULevel* Level, ULevelStreaming*
 		return;
 	}
 
-	const float StartMS = GetTimeMilliseconds();
+	if (StartMS <= 0)
+	{
+		StartMS = GetTimeMilliseconds();
+	}
 
 	CurrentLevel = Level;
 	CurrentSLevel = StreamingLevel;
 	CurrentActorIndex = 0;
+	CurrentLevelActors.Empty();
+	ActorQueue.Empty();
+
+	TArray<FVector> ViewLocations;
+	if (Preset->bPrioritizeByDistance)
+	{
+		GetViewLocations(ViewLocations);
+	}
 
 	// Copy actors array. New actors won't be considered for deserialization
-	CurrentLevelActors.Empty(Level->Actors.Num());
-	for (auto* Actor : Level->Actors)
+	if (ViewLocations.Num() > 0)
+	{
+		// Actors will be placed where they were saved, so that is their priority
+		auto GetSavedLocation = [this, LevelRecord](const AActor* Actor) {
+			const int32 RecordIndex = FindActorRecordIndex(*LevelRecord, Actor);
+			return RecordIndex != INDEX_NONE && FSELevelFilter::StoresTransform(Actor)
+				? LevelRecord->Actors[RecordIndex].Transform.GetLocation()
+				: Actor->GetActorLocation();
+		};
+
+		ActorQueue.Reserve(Level->Actors.Num());
+		for (AActor* Actor : Level->Actors)
+		{
+			if (IsValid(Actor))
+			{
+				// Attached actors share the priority of their top parent and go after it
+				const AActor* Root = nullptr;
+				const int32 Depth = Loader::GetAttachmentDepth(Actor, Root);
+				const float Distance = Loader::GetDistanceSquared(ViewLocations, GetSavedLocation(Root));
+				ActorQueue.Add({ Actor, Distance, Depth });
+			}
+		}
+		ActorQueue.Heapify();
+	}
+	else
 	{
-		if(IsValid(Actor))
+		CurrentLevelActors.Reserve(Level->Actors.Num());
+		for (auto* Actor : Level->Actors)
 		{
-			CurrentLevelActors.Add(Actor);
+			if(IsValid(Actor))
+			{
+				CurrentLevelActors.Add(Actor);
+			}
 		}
+		Loader::SortParentsFirst(CurrentLevelActors);
 	}
 
 	DeserializeASyncLoop(StartMS);
@@ -343,9 +693,9 @@ void USlotDataTask_Loader::DeserializeASyncLoop(float StartMS)
 	}
 
 	// Continue Iterating actors every tick
-	for (; CurrentActorIndex < CurrentLevelActors.Num(); ++CurrentActorIndex)
+	AActor* Actor = nullptr;
+	while (PopNextAsyncActor(Actor))
 	{
-		AActor* const Actor{ CurrentLevelActors[CurrentActorIndex].Get() };
 		if (IsValid(Actor) && Filter.ShouldSave(Actor))
 		{
 			DeserializeLevel_Actor(Actor, *LevelRecord, Filter);
@@ -354,10 +704,12 @@ void USlotDataTask_Loader::DeserializeASyncLoop(float StartMS)
 			// If x milliseconds passed, stop and continue on next frame
 			if (CurrentMS - StartMS >= MaxFrameMs)
 			{
+				FlushMovementUpdates();
 				return;
 			}
 		}
 	}
+	FlushMovementUpdates();
 
 	ULevelStreaming* CurrentLevelStreaming = CurrentSLevel.Get();
 	FindNextAsyncLevel(CurrentLevelStreaming);
@@ -367,7 +719,7 @@ void USlotDataTask_Loader::DeserializeASyncLoop(float StartMS)
 		CurrentLevel = CurrentLevelStreaming->GetLoadedLevel();
 		if (CurrentLevel.IsValid())
 		{
-			DeserializeLevelASync(CurrentLevel.Get(), CurrentLevelStreaming);
+			DeserializeLevelASync(CurrentLevel.Get(), CurrentLevelStreaming, StartMS);
 			return;
 		}
 	}
@@ -376,57 +728,169 @@ void USlotDataTask_Loader::DeserializeASyncLoop(float StartMS)
 	FinishedDeserializing();
 }
 
-void USlotDataTask_Loader::PrepareLevel(const ULevel* Level, FLevelRecord& LevelRecord)
+bool USlotDataTask_Loader::PrepareLevel(const ULevel* Level, FLevelRecord& LevelRecord, bool bFrameSplit, float StartMS)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Loader::PrepareLevel);
 
 	const auto& Filter = GetLevelFilter(LevelRecord);
+	FSEActorPool& Pool = GetManager()->GetActorPool();
+
+	const auto IsOutOfTime = [this, bFrameSplit, StartMS]()
+	{
+		return bFrameSplit && GetTimeMilliseconds() - StartMS >= MaxFrameMs;
+	};
 
 
 	// Records not contained in Scene Actors		 => Actors to be Respawned
 	// Scene Actors not contained in loaded records  => Actors to be Destroyed
 	// The rest									     => Just deserialize
 
-	TArray<FActorRecord*> ActorsToSpawn;
-	ActorsToSpawn.Reserve(LevelRecord.Actors.Num());
-	for(FActorRecord& Record : LevelRecord.Actors)
+	if (PrepareStep == EPrepareLevelStep::None)
 	{
-		ActorsToSpawn.Add(&Record);
+		PrepareStep = EPrepareLevelStep::Indexing;
+		CurrentRecordIndex = 0;
 	}
 
-	TArray<AActor*> ActorsToDestroy{};
+	if (PrepareStep == EPrepareLevelStep::Indexing)
 	{
-		// O(M*Log(N))
+		if (bFrameSplit)
+		{
+			// Index records in chunks on this thread
+			FActorRecordIndex& RecordIndex = ActorRecordIndices.FindOrAdd(LevelRecord.Name);
+			const int32 RecordCount = LevelRecord.Actors.Num();
+			while (CurrentRecordIndex < RecordCount)
+			{
+				const int32 Num = FMath::Min(Loader::IndexBatchSize, RecordCount - CurrentRecordIndex);
+				Loader::IndexRecords(LevelRecord, CurrentRecordIndex, Num, RecordIndex);
+				CurrentRecordIndex += Num;
+
+				if (IsOutOfTime())
+				{
+					return false;
+				}
+			}
+		}
+		else
+		{
+			GetActorRecordIndex(LevelRecord);
+		}
+
+		// Copy actors array. Actors spawned from now on won't be considered
+		CurrentLevelActors.Reset(Level->Actors.Num());
 		for (AActor* const Actor : Level->Actors)
 		{
-			// Remove records which actors do exist
-			const bool bFoundActorRecord = Loader::RemoveSingleRecordPtrSwap(ActorsToSpawn, Actor, false) > 0;
+			if (Actor)
+			{
+				CurrentLevelActors.Add(Actor);
+			}
+		}
+		CurrentActorIndex = 0;
+		FoundRecords.Init(false, LevelRecord.Actors.Num());
+		PrepareStep = EPrepareLevelStep::Destroying;
+	}
+
+	FActorRecordIndex& RecordIndex = GetActorRecordIndex(LevelRecord);
+
+	if (PrepareStep == EPrepareLevelStep::Destroying)
+	{
+		// O(M)
+		while (CurrentActorIndex < CurrentLevelActors.Num())
+		{
+			AActor* const Actor = CurrentLevelActors[CurrentActorIndex++].Get();
+
+			// Pooled actors are only reused through RespawnActors
+			if (!IsValid(Actor) || FSELevelFilter::IsPooled(Actor))
+			{
+				continue;
+			}
 
-			if (Actor && Filter.ShouldSave(Actor))
+			const int32 Index = FindActorRecordIndex(LevelRecord, Actor);
+			if (Index != INDEX_NONE)
+			{
+				FoundRecords[Index] = true;
+			}
+			else if (Filter.ShouldSave(Actor)) // Don't destroy level actors
 			{
-				if (!bFoundActorRecord) // Don't destroy level actors
+				// If the actor wasn't found, pool it or mark it for destruction
+				if (!CanPoolActor(Actor) || !Pool.Release(Actor, Preset->MaxPooledActorsPerClass))
 				{
-					// If the actor wasn't found, mark it for destruction
 					Actor->Destroy();
 				}
 			}
+
+			if (IsOutOfTime())
+			{
+				return false;
+			}
+		}
+
+		ActorsToSpawn.Reset();
+		for (int32 I = 0; I < LevelRecord.Actors.Num(); ++I)
+		{
+			// Records whose class doesn't exist anymore or whose data can't be read are not respawned
+			FActorRecord& Record = LevelRecord.Actors[I];
+			if (!FoundRecords[I] && Record.IsValid() && Record.Class->IsChildOf<AActor>())
+			{
+				ActorsToSpawn.Add(&Record);
+			}
 		}
-		ActorsToSpawn.Shrink();
+		CurrentLevelActors.Empty();
+		CurrentRecordIndex = 0;
+		PrepareStep = EPrepareLevelStep::Respawning;
 	}
 
-	// Create Actors that doesn't exist now but were saved
-	RespawnActors(ActorsToSpawn, Level);
+	if (PrepareStep == EPrepareLevelStep::Respawning)
+	{
+		// Create Actors that doesn't exist now but were saved
+		while (CurrentRecordIndex < ActorsToSpawn.Num())
+		{
+			const int32 Remaining = ActorsToSpawn.Num() - CurrentRecordIndex;
+			const int32 Num = bFrameSplit ? FMath::Min(Loader::RespawnBatchSize, Remaining) : Remaining;
+			RespawnActors(MakeArrayView(ActorsToSpawn).Slice(CurrentRecordIndex, Num), Level, Filter);
+			CurrentRecordIndex += Num;
+
+			if (CurrentRecordIndex < ActorsToSpawn.Num() && IsOutOfTime())
+			{
+				return false;
+			}
+		}
+
+		// Respawned actors may have been renamed
+		for (const FActorRecord* Record : ActorsToSpawn)
+		{
+			RecordIndex.Add(Record->Name, int32(Record - LevelRecord.Actors.GetData()));
+		}
+		ActorsToSpawn.Empty();
+		FoundRecords.Empty();
+	}
+
+	PrepareStep = EPrepareLevelStep::None;
+	return true;
 }
 
 void USlotDataTask_Loader::FinishedDeserializing()
 {
+	FlushMovementUpdates();
+
 	// Clean serialization data
-	SlotData->CleanRecords(true);
+	ActorRecordIndices.Empty();
+	CurrentLevelActors.Empty();
+	RespawnedActors.Empty();
+	ReleaseRecords();
 	GetManager()->__SetCurrentData(SlotData);
 
 	Finish(true);
 }
 
+void USlotDataTask_Loader::ReleaseRecords()
+{
+	// Records are kept when reusing data, so that the next load reuses their memory
+	if (!Preset->bReuseSlotData)
+	{
+		SlotData->CleanRecords(true);
+	}
+}
+
 void USlotDataTask_Loader::PrepareAllLevels()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Loader::PrepareAllLevels);
@@ -434,11 +898,12 @@ void USlotDataTask_Loader::PrepareAllLevels()
 	const UWorld* World = GetWorld();
 	check(World);
 
+	const TArray<ULevelStreaming*>& Levels = World->GetStreamingLevels();
+
 	// Prepare Main level
 	PrepareLevel(World->GetCurrentLevel(), SlotData->MainLevel);
 
 	// Prepare other loaded sub-levels
-	const TArray<ULevelStreaming*>& Levels = World->GetStreamingLevels();
 	for (const ULevelStreaming* Level : Levels)
 	{
 		if (Level->IsLevelLoaded())
@@ -452,36 +917,136 @@ void USlotDataTask_Loader::PrepareAllLevels()
 	}
 }
 
-void USlotDataTask_Loader::RespawnActors(const TArray<FActorRecord*>& Records, const ULevel* Level)
+FActorRecordIndex& USlotDataTask_Loader::GetActorRecordIndex(const FLevelRecord& LevelRecord)
+{
+	if (FActorRecordIndex* Index = ActorRecordIndices.Find(LevelRecord.Name))
+	{
+		return *Index;
+	}
+
+	FActorRecordIndex& Index = ActorRecordIndices.Add(LevelRecord.Name);
+	Loader::IndexRecords(LevelRecord, 0, LevelRecord.Actors.Num(), Index);
+	return Index;
+}
+
+int32 USlotDataTask_Loader::FindActorRecordIndex(const FLevelRecord& LevelRecord, const AActor* Actor)
+{
+	const int32* const Index = GetActorRecordIndex(LevelRecord).Find(Actor->GetFName());
+	if (Index && LevelRecord.Actors.IsValidIndex(*Index) && LevelRecord.Actors[*Index] == Actor)
+	{
+		return *Index;
+	}
+	return INDEX_NONE;
+}
+
+void USlotDataTask_Loader::RespawnActors(TArrayView<FActorRecord* const> Records, const ULevel* Level, const FSELevelFilter& Filter)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Loader::RespawnActors);
 
 	FActorSpawnParameters SpawnInfo{};
 	SpawnInfo.OverrideLevel = const_cast<ULevel*>(Level);
 	SpawnInfo.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+	SpawnInfo.bDeferConstruction = Preset->bDeferRespawnConstruction;
 
 	UWorld* const World = GetWorld();
+	FSEActorPool& Pool = GetManager()->GetActorPool();
 
 	// Respawn all procedural actors
+	TArray<AActor*> NewActors;
+	TArray<FActorRecord*> NewRecords;
+	NewActors.Reserve(Records.Num());
+	NewRecords.Reserve(Records.Num());
 	for (auto* Record : Records)
 	{
+		if (Preset->bUseActorPool && Preset->PooledActorFilter.IsClassAllowed(Record->Class))
+		{
+			if (AActor* const PooledActor = Pool.Acquire(Record->Class, Level, Record->Name))
+			{
+				// Reused actors are already constructed. They get deserialized with the rest of the level
+				PooledActor->SetActorTransform(Record->Transform, false, nullptr, ETeleportType::ResetPhysics);
+				Record->Name = PooledActor->GetFName();
+				continue;
+			}
+		}
+
 		SpawnInfo.Name = Record->Name;
 		auto* NewActor = World->SpawnActor(Record->Class, &Record->Transform, SpawnInfo);
 
 		// We update the name on the record in case it changed
-		Record->Name = NewActor->GetFName();
+		if (NewActor)
+		{
+			Record->Name = NewActor->GetFName();
+		}
+		NewActors.Add(NewActor);
+		NewRecords.Add(Record);
+	}
+
+	if (!SpawnInfo.bDeferConstruction)
+	{
+		// Actors will be deserialized with the rest of the level
+		return;
+	}
+
+	// Apply saved state before construction scripts and BeginPlay run
+	for (int32 I = 0; I < NewActors.Num(); ++I)
+	{
+		if (AActor* const Actor = NewActors[I])
+		{
+			const FActorRecord& Record = *NewRecords[I];
+			Actor->Tags = Record.Tags;
+			Actor->SetActorHiddenInGame(Record.bHiddenInGame);
+			DeserializeActorComponents(Actor, Record, Filter, 2, EComponentsToLoad::Native);
+			if (Record.IsValid())
+			{
+				DeserializeActorData(Actor, Record);
+			}
+		}
 	}
+
+	// Finish spawning as a batch. Components created by construction scripts only exist after this
+	for (int32 I = 0; I < NewActors.Num(); ++I)
+	{
+		AActor* const Actor = NewActors[I];
+		if (!Actor)
+		{
+			continue;
+		}
+
+		const FActorRecord& Record = *NewRecords[I];
+		Actor->FinishSpawning(Record.Transform);
+		if (IsValid(Actor))
+		{
+			DeserializeActorPhysics(Actor, Record);
+			DeserializeActorComponents(Actor, Record, Filter, 2, EComponentsToLoad::Constructed);
+
+			// Already deserialized, don't do it again with the rest of the level.
+			// Their deferred movement is flushed once the level is deserialized
+			RespawnedActors.Add(Actor);
+		}
+	}
+}
+
+bool USlotDataTask_Loader::CanPoolActor(const AActor* Actor) const
+{
+	// Only actors spawned during gameplay. Actors placed on the level are never pooled
+	return Preset->bUseActorPool && !Actor->HasAnyFlags(RF_WasLoaded | RF_LoadCompleted)
+		&& Preset->PooledActorFilter.IsClassAllowed(Actor->GetClass());
 }
 
 void USlotDataTask_Loader::DeserializeLevel_Actor(AActor* const Actor, const FLevelRecord& LevelRecord, const FSELevelFilter& Filter)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Loader::DeserializeLevel_Actor);
 
+	if (RespawnedActors.Contains(Actor))
+	{
+		return;
+	}
+
 	// Find the record
-	const FActorRecord* const Record = LevelRecord.Actors.FindByKey(Actor);
-	if (Record && Record->IsValid() && Record->Class == Actor->GetClass())
+	const int32 RecordIndex = FindActorRecordIndex(LevelRecord, Actor);
+	if (RecordIndex != INDEX_NONE && LevelRecord.Actors[RecordIndex].IsValid())
 	{
-		DeserializeActor(Actor, *Record, Filter);
+		DeserializeActor(Actor, LevelRecord.Actors[RecordIndex], Filter);
 	}
 }
 
@@ -512,46 +1077,56 @@ bool USlotDataTask_Loader::DeserializeActor(AActor* Actor, const FActorRecord& R
 	// Always load saved tags
 	Actor->Tags = Record.Tags;
 
-	const bool bSavesPhysics = FSELevelFilter::StoresPhysics(Actor);
 	if (FSELevelFilter::StoresTransform(Actor))
 	{
+		DeferMovementUpdates(Actor->GetRootComponent());
 		Actor->SetActorTransform(Record.Transform);
-
-		if (FSELevelFilter::StoresPhysics(Actor))
-		{
-			USceneComponent* Root = Actor->GetRootComponent();
-			if (auto* Primitive = Cast<UPrimitiveComponent>(Root))
-			{
-				Primitive->SetPhysicsLinearVelocity(Record.LinearVelocity);
-				Primitive->SetPhysicsAngularVelocityInRadians(Record.AngularVelocity);
-			}
-			else
-			{
-				Root->ComponentVelocity = Record.LinearVelocity;
-			}
-		}
+		DeserializeActorPhysics(Actor, Record);
 	}
 
 	Actor->SetActorHiddenInGame(Record.bHiddenInGame);
 
 	DeserializeActorComponents(Actor, Record, Filter, 2);
 
+	DeserializeActorData(Actor, Record);
+	return true;
+}
+
+void USlotDataTask_Loader::DeserializeActorPhysics(AActor* Actor, const FActorRecord& Record)
+{
+	if (FSELevelFilter::StoresPhysics(Actor))
 	{
-		//Serialize from Record Data
-		FMemoryReader MemoryReader(Record.Data, true);
-		FSEArchive Archive(MemoryReader, false);
-		Actor->Serialize(Archive);
+		USceneComponent* Root = Actor->GetRootComponent();
+		if (auto* Primitive = Cast<UPrimitiveComponent>(Root))
+		{
+			Primitive->SetPhysicsLinearVelocity(Record.LinearVelocity);
+			Primitive->SetPhysicsAngularVelocityInRadians(Record.AngularVelocity);
+		}
+		else if (Root)
+		{
+			Root->ComponentVelocity = Record.LinearVelocity;
+		}
 	}
+}
 
-	return true;
+void USlotDataTask_Loader::DeserializeActorData(AActor* Actor, const FActorRecord& Record)
+{
+	//Serialize from Record Data
+	FMemoryReader MemoryReader(Record.Data, true);
+	FSEArchive Archive(MemoryReader, false);
+	Actor->Serialize(Archive);
 }
 
-void USlotDataTask_Loader::DeserializeActorComponents(AActor* Actor, const FActorRecord& ActorRecord, const FSELevelFilter& Filter, int8 Indent)
+void USlotDataTask_Loader::DeserializeActorComponents(AActor* Actor, const FActorRecord& ActorRecord,
+	const FSELevelFilter& Filter, int8 Indent, EComponentsToLoad Selection)
 {
 	if (Filter.bStoreComponents)
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(UUSlotDataTask_Loader::DeserializeActorComponents);
 
+		int32 NextRecordIndex = 0;
+		TMap<FName, int32> RecordIndices;
+
 		const TSet<UActorComponent*>& Components = Actor->GetComponents();
 		for (auto* Component : Components)
 		{
@@ -560,8 +1135,18 @@ void USlotDataTask_Loader::DeserializeActorComponents(AActor* Actor, const FActo
 				continue;
 			}
 
+			if (Selection != EComponentsToLoad::All)
+			{
+				const bool bIsNative = Component->CreationMethod == EComponentCreationMethod::Native;
+				if (bIsNative != (Selection == EComponentsToLoad::Native))
+				{
+					continue;
+				}
+			}
+
 			// Find the record
-			const FComponentRecord* Record = ActorRecord.ComponentRecords.FindByKey(Component);
+			const FComponentRecord* Record = Loader::FindComponentRecord(
+				ActorRecord.ComponentRecords, Component, NextRecordIndex, RecordIndices);
 			if (!Record)
 			{
 				SELog(Preset, "Component '" + Component->GetFName().ToString() + "' - Record not found", FColor::Red, false, Indent + 1);
@@ -573,6 +1158,7 @@ void USlotDataTask_Loader::DeserializeActorComponents(AActor* Actor, const FActo
 				USceneComponent* Scene = CastChecked<USceneComponent>(Component);
 				if (Scene->Mobility == EComponentMobility::Movable)
 				{
+					DeferMovementUpdates(Scene);
 					Scene->SetRelativeTransform(Record->Transform);
 				}
 			}
@@ -582,7 +1168,8 @@ void USlotDataTask_Loader::DeserializeActorComponents(AActor* Actor, const FActo
 				Component->ComponentTags = Record->Tags;
 			}
 
-			if (!Component->GetClass()->IsChildOf<UPrimitiveComponent>())
+			// Data of invalid records is discarded while loading
+			if (!Component->GetClass()->IsChildOf<UPrimitiveComponent>() && Record->Data.Num() > 0)
 			{
 				FMemoryReader MemoryReader(Record->Data, true);
 				FSEArchive Archive(MemoryReader, false);
@@ -592,33 +1179,175 @@ void USlotDataTask_Loader::DeserializeActorComponents(AActor* Actor, const FActo
 	}
 }
 
-void USlotDataTask_Loader::FindNextAsyncLevel(ULevelStreaming*& OutLevelStreaming) const
+void USlotDataTask_Loader::DeferMovementUpdates(USceneComponent* Component)
+{
+	if (!Component || !Component->IsRegistered() || Component->Mobility != EComponentMobility::Movable
+		|| Component->IsDeferringMovementUpdates())
+	{
+		return;
+	}
+
+	// Simulated bodies get their velocities right after being moved. Keep them immediate
+	const auto* Primitive = Cast<UPrimitiveComponent>(Component);
+	if (Primitive && Primitive->IsSimulatingPhysics())
+	{
+		return;
+	}
+
+	MovementScopes.Add(MakeUnique<FScopedMovementUpdate>(Component, EScopedUpdate::DeferredUpdates));
+}
+
+void USlotDataTask_Loader::FlushMovementUpdates()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Loader::FlushMovementUpdates);
+
+	// Scopes must end in reverse order
+	for (int32 I = MovementScopes.Num() - 1; I >= 0; --I)
+	{
+		MovementScopes[I].Reset();
+	}
+	MovementScopes.Reset();
+}
+
+void USlotDataTask_Loader::FindNextAsyncLevel(ULevelStreaming*& OutLevelStreaming)
 {
 	OutLevelStreaming = nullptr;
 
+	if (Preset->bPrioritizeByDistance)
+	{
+		// Closest loaded level first
+		while (LevelQueue.Num() > 0)
+		{
+			TLoadPriority<ULevelStreaming> Next;
+			LevelQueue.HeapPop(Next, false);
+			ULevelStreaming* const Level = Next.Object.Get();
+			if (Level && Level->IsLevelLoaded())
+			{
+				OutLevelStreaming = Level;
+				return;
+			}
+		}
+		return;
+	}
+
 	const UWorld* World = GetWorld();
 	const TArray<ULevelStreaming*>& Levels = World->GetStreamingLevels();
-	if (CurrentLevel.IsValid() && Levels.Num() > 0)
+
+	// If current is persistent, start from the first streaming level.
+	// The current level may have been unloaded, but its streaming level keeps its position
+	int32 Index = 0;
+	if (!CurrentSLevel.IsExplicitlyNull())
 	{
-		if (!CurrentSLevel.IsValid())
+		Index = Levels.IndexOfByKey(CurrentSLevel);
+		if (Index == INDEX_NONE)
 		{
-			//Current is persistent, get first streaming level
-			OutLevelStreaming = Levels[0];
 			return;
 		}
-		else
+		++Index;
+	}
+
+	// Skip unloaded levels
+	for (; Index < Levels.Num(); ++Index)
+	{
+		if (Levels[Index] && Levels[Index]->IsLevelLoaded())
+		{
+			OutLevelStreaming = Levels[Index];
+			return;
+		}
+	}
+}
+
+void USlotDataTask_Loader::QueueAsyncLevels()
+{
+	LevelQueue.Empty();
+	if (!Preset->bPrioritizeByDistance)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Loader::QueueAsyncLevels);
+
+	const UWorld* World = GetWorld();
+	TArray<FVector> ViewLocations;
+	GetViewLocations(ViewLocations);
+
+	for (ULevelStreaming* LevelStreaming : World->GetStreamingLevels())
+	{
+		ULevel* const Level = LevelStreaming? LevelStreaming->GetLoadedLevel() : nullptr;
+		if (!Level)
+		{
+			continue;
+		}
+
+		const FBox Bounds = Level->LevelBoundsActor.IsValid()
+			? Level->LevelBoundsActor->GetComponentsBoundingBox(true)
+			: ALevelBounds::CalculateLevelBounds(Level);
+		LevelQueue.Add({ LevelStreaming, Loader::GetDistanceSquared(ViewLocations, Bounds) });
+	}
+	LevelQueue.Heapify();
+}
+
+void USlotDataTask_Loader::GetViewLocations(TArray<FVector>& OutLocations)
+{
+	const UWorld* World = GetWorld();
+	for (auto It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* Controller = It->Get();
+		if (!Controller)
+		{
+			continue;
+		}
+
+		// Players will view from where their pawns were saved, not from where they are now
+		const APawn* Pawn = Controller->GetPawn();
+		FLevelRecord* LevelRecord = nullptr;
+		if (Pawn && FSELevelFilter::StoresTransform(Pawn))
 		{
-			int32 CurrentIndex = Levels.IndexOfByKey(CurrentSLevel);
-			if (CurrentIndex != INDEX_NONE && Levels.Num() > CurrentIndex + 1)
+			if (Pawn->GetLevel() == World->GetCurrentLevel())
+			{
+				LevelRecord = &SlotData->MainLevel;
+			}
+			else if (const ULevelStreaming* Level = World->GetLevelStreamingForPackageName(Pawn->GetLevel()->GetPackage()->GetFName()))
 			{
-				OutLevelStreaming = Levels[CurrentIndex + 1];
+				LevelRecord = FindLevelRecord(Level);
 			}
 		}
+
+		const int32 RecordIndex = LevelRecord ? FindActorRecordIndex(*LevelRecord, Pawn) : INDEX_NONE;
+		if (RecordIndex != INDEX_NONE)
+		{
+			const FVector EyeOffset{ 0.f, 0.f, Pawn->BaseEyeHeight };
+			OutLocations.Add(LevelRecord->Actors[RecordIndex].Transform.GetLocation() + EyeOffset);
+		}
+		else
+		{
+			GetCurrentViewLocation(Controller, OutLocations);
+		}
+	}
+}
+
+void USlotDataTask_Loader::GetCurrentViewLocation(const APlayerController* Controller, TArray<FVector>& OutLocations)
+{
+	FVector Location;
+	FRotator Rotation;
+	Controller->GetPlayerViewPoint(Location, Rotation);
+	OutLocations.Add(Location);
+}
+
+bool USlotDataTask_Loader::PopNextAsyncActor(AActor*& OutActor)
+{
+	if (ActorQueue.Num() > 0)
+	{
+		TLoadPriority<AActor> Next;
+		ActorQueue.HeapPop(Next, false);
+		OutActor = Next.Object.Get();
+		return true;
 	}
 
-	// If this level is unloaded, find next
-	if (OutLevelStreaming && !OutLevelStreaming->IsLevelLoaded())
+	if (CurrentLevelActors.IsValidIndex(CurrentActorIndex))
 	{
-		FindNextAsyncLevel(OutLevelStreaming);
+		OutActor = CurrentLevelActors[CurrentActorIndex++].Get();
+		return true;
 	}
+	return false;
 }
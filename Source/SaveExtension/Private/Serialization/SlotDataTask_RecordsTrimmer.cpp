@@ -0,0 +1,15 @@
+// Copyright 2015-2020 Piperift. All Rights Reserved.
+
+#include "Serialization/SlotDataTask_RecordsTrimmer.h"
+
+#include "SaveManager.h"
+
+
+/////////////////////////////////////////////////////
+// USlotDataTask_RecordsTrimmer
+
+void USlotDataTask_RecordsTrimmer::OnStart()
+{
+	GetManager()->TrimSubLevelRecords();
+	Finish(true);
+}
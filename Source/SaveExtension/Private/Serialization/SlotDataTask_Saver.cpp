@@ -24,13 +24,15 @@ void USlotDataTask_Saver::OnStart()
 
 	bool bSave = true;
 	const FString SlotNameStr = SlotName.ToString();
-	//Overriding
+	const bool bStreamed = Preset->bStreamRecords && !bSnapshot;
+	//Overriding. Snapshots only touch disk if flushed
+	if (!bSnapshot || bFlushSnapshot)
 	{
 		const bool bFileExists = FFileAdapter::DoesFileExist(SlotNameStr);
 		if (bOverride)
 		{
-			// Delete previous save
-			if (bFileExists)
+			// Delete previous save. Streamed saves replace it only once written, keeping it if they fail
+			if (bFileExists && !bStreamed)
 			{
 				FFileAdapter::DeleteFile(SlotNameStr);
 			}
@@ -60,7 +62,19 @@ void USlotDataTask_Saver::OnStart()
 
 		if (bSaveThumbnail)
 		{
-			SlotInfo->CaptureThumbnail(Width, Height);
+			if (Preset->bEmbedThumbnails)
+			{
+				ThumbnailCapture = FSEThumbnailCapture::Start(World, Width, Height);
+			}
+			else
+			{
+				SlotInfo->CaptureThumbnail(Width, Height);
+			}
+		}
+		if (!ThumbnailCapture)
+		{
+			// The thumbnail of a previous save doesn't show this one
+			SlotInfo->_SetEmbeddedThumbnail({});
 		}
 
 		// Time stats
@@ -99,6 +113,16 @@ void USlotDataTask_Saver::OnStart()
 		SlotData->bStoreGameInstance = Preset->bStoreGameInstance;
 		SlotData->GeneralLevelFilter = Preset->ToFilter();
 
+		if (bStreamed)
+		{
+			Stream = MakeUnique<FSaveFileStream>(SlotNameStr, Preset->bUseCompression);
+			if (!Stream->IsValid())
+			{
+				SELog(Preset, "Can't stream records of slot '" + SlotNameStr + "'. Saving them at once", FColor::Yellow);
+				Stream.Reset();
+			}
+		}
+
 		SerializeWorld();
 		SaveFile();
 		return;
@@ -111,9 +135,17 @@ void USlotDataTask_Saver::Tick(float DeltaTime)
 	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Saver::Tick);
 	Super::Tick(DeltaTime);
 
+	if (bWaitingForThumbnail && ThumbnailCapture->IsDone())
+	{
+		bWaitingForThumbnail = false;
+		SaveFile();
+		return;
+	}
+
 	if (SaveTask && SaveTask->IsDone())
 	{
-		if (bSaveThumbnail)
+		// Embedded thumbnails were already written with the file
+		if (bSaveThumbnail && !Preset->bEmbedThumbnails)
 		{
 			if (SlotInfo && SlotInfo->GetThumbnail())
 			{
@@ -127,9 +159,33 @@ void USlotDataTask_Saver::Tick(float DeltaTime)
 	}
 }
 
+void USlotDataTask_Saver::FinishNow()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	if (bWaitingForThumbnail)
+	{
+		// Rendering is not waited for. The slot is saved without its thumbnail
+		bWaitingForThumbnail = false;
+		ThumbnailCapture.Reset();
+		SaveFile();
+	}
+
+	if (SaveTask && IsRunning())
+	{
+		SaveTask->EnsureCompletion(false);
+		Finish(true);
+	}
+}
+
 void USlotDataTask_Saver::OnFinish(bool bSuccess)
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Saver::OnFinish);
+	USaveManager* Manager = GetManager();
+	check(Manager);
 	if (bSuccess)
 	{
 		// Clean serialization data
@@ -138,16 +194,32 @@ void USlotDataTask_Saver::OnFinish(bool bSuccess)
 		SELog(Preset, "Finished Saving", FColor::Green);
 	}
 
+	// Only files that were written are listed
+	if (SaveTask && SaveTask->IsDone() && SaveTask->GetTask().IsSaved())
+	{
+		Manager->__UpdateSlotIndex(SavedSummary);
+	}
+
 	// Execute delegates
-	USaveManager* Manager = GetManager();
-	check(Manager);
-	Delegate.ExecuteIfBound((Manager && bSuccess)? Manager->GetCurrentInfo() : nullptr);
+	for (const FOnGameSaved& Delegate : Delegates)
+	{
+		Delegate.ExecuteIfBound((Manager && bSuccess)? Manager->GetCurrentInfo() : nullptr);
+	}
 	Manager->OnSaveFinished(
 		SlotData? GetGeneralFilter() : FSELevelFilter{},
 		!bSuccess
 	);
 }
 
+void USlotDataTask_Saver::OnCancel()
+{
+	SELog(Preset, "Cancelled saving to Slot " + SlotName.ToString());
+	for (const FOnGameSaved& Delegate : Delegates)
+	{
+		Delegate.ExecuteIfBound(nullptr);
+	}
+}
+
 void USlotDataTask_Saver::BeginDestroy()
 {
 	if (SaveTask)
@@ -159,6 +231,16 @@ void USlotDataTask_Saver::BeginDestroy()
 	Super::BeginDestroy();
 }
 
+FSlotDataTaskAccess USlotDataTask_Saver::GetAccess() const
+{
+	if (SaveTask)
+	{
+		// Records are only read while the file is written. Snapshots were already serialized
+		return bSnapshot ? FSlotDataTaskAccess{} : FSlotDataTaskAccess::ReadAll();
+	}
+	return FSlotDataTaskAccess::WriteAll();
+}
+
 void USlotDataTask_Saver::SerializeWorld()
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Saver::SerializeWorld);
@@ -231,6 +313,7 @@ void USlotDataTask_Saver::SerializeLevelSync(const ULevel* Level, int32 Assigned
 	LevelRecord->CleanRecords();
 
 	auto& Filter = GetLevelFilter(*LevelRecord);
+	const int32 LevelIndex = StreamingLevel ? int32(static_cast<FStreamingLevelRecord*>(LevelRecord) - SlotData->SubLevels.GetData()) : INDEX_NONE;
 
 	const int32 MinObjectsPerTask = 40;
 	const int32 ActorCount = Level->Actors.Num();
@@ -252,6 +335,10 @@ void USlotDataTask_Saver::SerializeLevelSync(const ULevel* Level, int32 Assigned
 			GetWorld(), SlotData, &Level->Actors, Index, NumToSerialize,
 			bStoreGameInstance, LevelRecord, Filter
 		});
+		if (Stream)
+		{
+			Tasks.Last().GetTask().StreamRecords(*Stream, LevelIndex);
+		}
 
 		Index += NumToSerialize;
 	}
@@ -291,19 +378,61 @@ void USlotDataTask_Saver::SaveFile()
 	TRACE_CPUPROFILER_EVENT_SCOPE(USlotDataTask_Saver::SaveFile);
 	USaveManager* Manager = GetManager();
 
-	SaveTask = new FAsyncTask<FSaveFileTask>(
-		Manager->GetCurrentInfo(), Manager->GetCurrentData(),
-		SlotName.ToString(), Preset->bUseCompression);
+	if (ThumbnailCapture)
+	{
+		// The thumbnail goes in the header, so it must be ready before writing
+		if (!ThumbnailCapture->IsDone())
+		{
+			bWaitingForThumbnail = true;
+			return;
+		}
+		Manager->GetCurrentInfo()->_SetEmbeddedThumbnail(ThumbnailCapture->ConsumeImage());
+		ThumbnailCapture.Reset();
+	}
+
+	if (bSnapshot)
+	{
+		// Serialized without compression. Restoring from memory is then as fast as possible
+		FSaveFile File{};
+		File.SerializeInfo(Manager->GetCurrentInfo());
+		File.SerializeData(Manager->GetCurrentData());
+
+		if (!bFlushSnapshot)
+		{
+			Manager->__AddSnapshot(MoveTemp(File));
+			Finish(true);
+			return;
+		}
+
+		SaveTask = new FAsyncTask<FSaveFileTask>(FSaveFile{ File }, SlotName.ToString(), Preset->bUseCompression);
+		Manager->__AddSnapshot(MoveTemp(File));
+	}
+	else if (Stream)
+	{
+		// Actor records were already written. Only the rest of the slot is left
+		SaveTask = new FAsyncTask<FSaveFileTask>(
+			MoveTemp(Stream), Manager->GetCurrentInfo(), Manager->GetCurrentData(), SlotName.ToString());
+	}
+	else
+	{
+		SaveTask = new FAsyncTask<FSaveFileTask>(
+			Manager->GetCurrentInfo(), Manager->GetCurrentData(),
+			SlotName.ToString(), Preset->bUseCompression);
+	}
+	SavedSummary = FSlotSummary{ *Manager->GetCurrentInfo() };
 
 	if (Preset->IsMTFilesSave())
 	{
 		SaveTask->StartBackgroundTask();
+
+		// Other tasks can run while the file is written
+		OnAccessReduced();
 	}
 	else
 	{
 		SaveTask->StartSynchronousTask();
 
-		if (!bSaveThumbnail)
+		if (!bSaveThumbnail || Preset->bEmbedThumbnails)
 		{
 			Finish(true);
 		}
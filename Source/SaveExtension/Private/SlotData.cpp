@@ -16,6 +16,66 @@
  */
 #define GET_PRIVATE(InClass, InObj, MemberName) (*InObj).*GetPrivate(InClass##MemberName##Accessor())
 
+/** Records are serialized the same way from a SlotData or from FSlotDataRecords */
+template<typename T>
+static void SerializeGlobalsOf(FArchive& Ar, T& Owner)
+{
+	Ar << Owner.bStoreGameInstance;
+	Ar << Owner.GameInstance;
+
+	static UScriptStruct* const LevelFilterType{ FSELevelFilter::StaticStruct() };
+	if (Ar.IsLoading())
+	{
+		// Records can be reused. Properties at their defaults are not loaded
+		Owner.GeneralLevelFilter = {};
+	}
+	LevelFilterType->SerializeItem(Ar, &Owner.GeneralLevelFilter, nullptr);
+}
+
+template<typename T>
+static void SerializeRecordsOf(FArchive& Ar, T& Owner, bool bLazySubLevels)
+{
+	SerializeGlobalsOf(Ar, Owner);
+	Owner.MainLevel.Serialize(Ar);
+	if (!bLazySubLevels)
+	{
+		SERecords::SerializeArray(Ar, Owner.SubLevels);
+		return;
+	}
+
+	int32 Num = Owner.SubLevels.Num();
+	Ar << Num;
+	if (Ar.IsLoading())
+	{
+		if (Num < 0 || Ar.IsError())
+		{
+			Ar.SetError();
+			Owner.SubLevels.Reset();
+			return;
+		}
+		Owner.SubLevels.SetNum(Num, false);
+	}
+	for (FStreamingLevelRecord& Level : Owner.SubLevels)
+	{
+		Level.SerializeLazy(Ar);
+	}
+}
+
+
+/////////////////////////////////////////////////////
+// FSlotDataRecords
+
+void FSlotDataRecords::Serialize(FArchive& Ar, bool bLazySubLevels)
+{
+	SerializeRecordsOf(Ar, *this, bLazySubLevels);
+}
+
+void FSlotDataRecords::SerializeGlobals(FArchive& Ar)
+{
+	SerializeGlobalsOf(Ar, *this);
+}
+
+
 /////////////////////////////////////////////////////
 // USlotData
 
@@ -23,13 +83,35 @@ void USlotData::Serialize(FArchive& Ar)
 {
 	Super::Serialize(Ar);
 
-	Ar << bStoreGameInstance;
-	Ar << GameInstance;
+	if (!bSkipRecords)
+	{
+		SerializeRecordsOf(Ar, *this, false);
+	}
+}
 
-	static UScriptStruct* const LevelFilterType{ FSELevelFilter::StaticStruct() };
-	LevelFilterType->SerializeItem(Ar, &GeneralLevelFilter, nullptr);
-	MainLevel.Serialize(Ar);
-	Ar << SubLevels;
+void USlotData::SerializeProperties(FArchive& Ar)
+{
+	TGuardValue<bool> SkipRecords(bSkipRecords, true);
+	Serialize(Ar);
+}
+
+void USlotData::SerializeRecords(FArchive& Ar, bool bLazySubLevels)
+{
+	SerializeRecordsOf(Ar, *this, bLazySubLevels);
+}
+
+void USlotData::SerializeGlobals(FArchive& Ar)
+{
+	SerializeGlobalsOf(Ar, *this);
+}
+
+void USlotData::SwapRecords(FSlotDataRecords& Records)
+{
+	Swap(bStoreGameInstance, Records.bStoreGameInstance);
+	Swap(GameInstance, Records.GameInstance);
+	Swap(GeneralLevelFilter, Records.GeneralLevelFilter);
+	Swap(MainLevel, Records.MainLevel);
+	Swap(SubLevels, Records.SubLevels);
 }
 
 void USlotData::CleanRecords(bool bKeepSublevels)
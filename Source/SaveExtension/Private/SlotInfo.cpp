@@ -1,6 +1,7 @@
 // Copyright 2015-2020 Piperift. All Rights Reserved.
 
 #include "SlotInfo.h"
+#include "Misc/SlotHelpers.h"
 
 #include <EngineUtils.h>
 #include <IImageWrapper.h>
@@ -11,9 +12,36 @@
 #include <Engine/Engine.h>
 
 
+FSlotSummary::FSlotSummary(const USlotInfo& Info)
+	: FileName(Info.FileName)
+	, DisplayName(Info.DisplayName)
+	, PlayedTime(Info.PlayedTime)
+	, SlotPlayedTime(Info.SlotPlayedTime)
+	, SaveDate(Info.SaveDate)
+	, Map(Info.Map)
+{}
+
+FArchive& operator<<(FArchive& Ar, FSlotSummary& Summary)
+{
+	Ar << Summary.DisplayName;
+	Ar << Summary.PlayedTime;
+	Ar << Summary.SlotPlayedTime;
+	Ar << Summary.SaveDate;
+
+	// Names are written as strings since the file has no name table
+	FString MapName = Summary.Map.ToString();
+	Ar << MapName;
+	if (Ar.IsLoading())
+	{
+		Summary.Map = FName{ MapName };
+	}
+	return Ar;
+}
+
+
 UTexture2D* USlotInfo::GetThumbnail() const
 {
-	if (ThumbnailPath.IsEmpty())
+	if (ThumbnailPath.IsEmpty() && EmbeddedThumbnail.Num() <= 0)
 	{
 		return nullptr;
 	}
@@ -23,24 +51,17 @@ UTexture2D* USlotInfo::GetThumbnail() const
 		return CachedThumbnail;
 	}
 
-	// Load thumbnail as Texture2D
+	// Load thumbnail as Texture2D. See USaveManager::RequestThumbnail to load it asynchronously
 	UTexture2D* Texture{ nullptr };
-	TArray<uint8> RawFileData;
-	if (GEngine && FFileHelper::LoadFileToArray(RawFileData, *ThumbnailPath))
+	TArray<uint8> RawFileData = EmbeddedThumbnail;
+	if (GEngine && (RawFileData.Num() > 0 || FFileHelper::LoadFileToArray(RawFileData, *ThumbnailPath)))
 	{
-		IImageWrapperModule & ImageWrapperModule = FModuleManager::LoadModuleChecked < IImageWrapperModule >(FName("ImageWrapper"));
-		TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
-		if (ImageWrapper.IsValid() && ImageWrapper->SetCompressed(RawFileData.GetData(), RawFileData.Num()))
+		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+		int32 Width, Height;
+		TArray64<uint8> UncompressedBGRA;
+		if (FSlotHelpers::DecodeThumbnail(ImageWrapperModule, RawFileData, Width, Height, UncompressedBGRA))
 		{
-			TArray64<uint8> UncompressedBGRA;
-			if (ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, UncompressedBGRA))
-			{
-				Texture = UTexture2D::CreateTransient(ImageWrapper->GetWidth(), ImageWrapper->GetHeight(), PF_B8G8R8A8);
-				void* TextureData = Texture->GetPlatformData()->Mips[0].BulkData.Lock(LOCK_READ_WRITE);
-				FMemory::Memcpy(TextureData, UncompressedBGRA.GetData(), UncompressedBGRA.Num());
-				Texture->GetPlatformData()->Mips[0].BulkData.Unlock();
-				Texture->UpdateResource();
-			}
+			Texture = FSlotHelpers::CreateThumbnailTexture(Width, Height, UncompressedBGRA);
 		}
 	}
 	const_cast<USlotInfo*>(this)->CachedThumbnail = Texture;
@@ -78,6 +99,12 @@ bool USlotInfo::CaptureThumbnail(const int32 Width /*= 640*/, const int32 Height
 	return false;
 }
 
+void USlotInfo::_SetEmbeddedThumbnail(TArray<uint8> Image)
+{
+	EmbeddedThumbnail = MoveTemp(Image);
+	CachedThumbnail = nullptr;
+}
+
 void USlotInfo::_SetThumbnailPath(const FString& Path)
 {
 	if (ThumbnailPath != Path)
@@ -9,14 +9,18 @@
 #include <Templates/SubclassOf.h>
 #include <Serialization/CustomVersion.h>
 #include <Serialization/ObjectAndNameAsStringProxyArchive.h>
+#include <UObject/SoftObjectPath.h>
 #include <PlatformFeatures.h>
+#include <Async/TaskGraphInterfaces.h>
 
 #include "ISaveExtension.h"
+#include "SlotInfo.h"
 
 
 class USavePreset;
 class USlotInfo;
 class USlotData;
+struct FSlotDataRecords;
 class FMemoryReader;
 class FMemoryWriter;
 
@@ -57,8 +61,21 @@ public:
 };
 
 
+/** Chunks of records in a file saved by FSaveFileStream */
+enum class ESERecordChunk : uint8
+{
+	End,
+	/** A batch of actors of a level */
+	Actors,
+	/** A level, apart from the actors streamed before it */
+	Level,
+	/** Records that don't belong to a level */
+	Globals
+};
+
+
 /** Based on GameplayStatics to add multi-threading */
-struct FSaveFile
+struct SAVEEXTENSION_API FSaveFile
 {
 	int32 FileTypeTag = 0;
 	int32 SaveGameFileVersion = 0;
@@ -67,26 +84,125 @@ struct FSaveFile
 	int32 CustomVersionFormat = int32(ECustomVersionSerializationFormat::Unknown);
 	FCustomVersionContainer CustomVersions;
 
+	/** Copied from the info, so that slots can be listed without deserializing it.
+	 * Only the save date is read from older files. See HasSummary()
+	 */
+	FSlotSummary Summary;
+	/** Compressed image embedded with the header. Empty if the slot has none or uses an image file */
+	TArray<uint8> ThumbnailBytes;
+	/** Offset where the thumbnail ends in the file. Known once its size is read, even if the header is not complete */
+	int64 ThumbnailEnd = 0;
+
 	FString InfoClassName;
 	TArray<uint8> InfoBytes;
 
+	/** Classes and assets referenced by the data. They can be loaded before deserializing it */
+	TArray<FSoftObjectPath> References;
+
 	FString DataClassName;
 	bool bIsDataCompressed = false;
+	/** If true records were saved as chunks by FSaveFileStream. RecordBytes then contains the decompressed chunks */
+	bool bRecordsChunked = false;
 	TArray<uint8> DataBytes;
+	/** Records of the data, apart from its properties so they can be decoded without objects.
+	 * Empty on older files, where DataBytes contains them. See HasRecordBytes()
+	 */
+	TArray<uint8> RecordBytes;
 
 
 	FSaveFile();
 
 	void Empty();
 	bool IsEmpty() const;
+	/** @return true if the file was saved with a complete summary */
+	bool HasSummary() const;
+	/** @return true if records are saved apart from the data */
+	bool HasRecordBytes() const;
+	/** @return true if sub-level records are saved encoded apart. See FStreamingLevelRecord::SerializeLazy */
+	bool HasLazySubLevels() const;
 
 	void Read(FScopedFileReader& Reader, bool bSkipData);
+	/** Reads everything until the data. @return false if the file has no data to read */
+	bool ReadHeader(FScopedFileReader& Reader)
+	{
+		return ReadHeader(Reader.GetArchive());
+	}
+	bool ReadHeader(FArchive& Ar);
+	void ReadData(FScopedFileReader& Reader);
 	void Write(FScopedFileWriter& Writer, bool bCompressData);
+	/** Writes the file followed by the records chunks already written by a stream */
+	void WriteStreamed(FArchive& Ar, FArchive& Chunks, bool bCompressData);
 
 	void SerializeInfo(USlotInfo* SlotInfo);
-	void SerializeData(USlotData* SlotData);
+	/** @param bWithRecords if false, only properties are serialized. Records are saved by a FSaveFileStream */
+	void SerializeData(USlotData* SlotData, bool bWithRecords = true);
+	/** Finds all classes and assets referenced by the records of a slot */
+	void CollectReferences(const USlotData* SlotData);
 	USlotInfo* CreateAndDeserializeInfo(const UObject* Outer) const;
-	USlotData* CreateAndDeserializeData(const UObject* Outer) const;
+	/**
+	 * @param Records if set, already decoded records are moved into the data instead of decoding them.
+	 * Only on the game thread if the file HasRecordBytes()
+	 */
+	USlotData* CreateAndDeserializeData(const UObject* Outer, FSlotDataRecords* Records = nullptr) const;
+	/** Deserializes into an existing data object. @return false if its class doesn't match or its records are corrupted */
+	bool DeserializeData(USlotData* Data, FSlotDataRecords* Records = nullptr) const;
+	/** Decodes only the records. Can run on any thread. @return false if the file has no record bytes or they are corrupted */
+	bool DeserializeRecords(FSlotDataRecords& OutRecords) const;
+
+	/** Writes bytes compressed on their own if needed */
+	static void WriteChunkPayload(FArchive& Ar, TArray<uint8>& Bytes, bool bCompressed);
+	static void ReadChunkPayload(FArchive& Ar, TArray<uint8>& OutBytes, bool bCompressed);
+
+private:
+
+	/** Writes everything until the data */
+	void WriteHeader(FArchive& Ar);
+	void ReadRecordChunks(FArchive& Ar);
+
+	static void SerializeReferences(FArchive& Ar, TArray<FSoftObjectPath>& InReferences);
+};
+
+
+/**
+ * Saves a slot while its records are serialized, so that they don't need to be kept in memory.
+ * Chunks of records are appended to a scratch file as they are produced.
+ * On Finish the slot file is written before them and replaces the previous one.
+ */
+class SAVEEXTENSION_API FSaveFileStream
+{
+	FString SlotName;
+	FString ScratchPath;
+	TUniquePtr<FArchive> Scratch;
+	bool bCompress = false;
+	/** Last chunk being written. Each chunk waits for the previous one, so they keep their order */
+	FGraphEventRef LastWrite;
+	FCriticalSection WriteLock;
+
+public:
+
+	FSaveFileStream(FStringView SlotName, bool bCompress);
+	~FSaveFileStream();
+
+	bool IsValid() const { return Scratch.IsValid() && !Scratch->IsError(); }
+	bool IsCompressed() const { return bCompress; }
+
+	/** Serializes and compresses a chunk. Can run on any thread */
+	static TArray<uint8> EncodeChunk(ESERecordChunk Type, int32 LevelIndex, bool bCompress, TFunctionRef<void(FArchive&)> Serialize);
+
+	/** Appends an encoded chunk to the scratch file on a background thread. Can be called from any thread.
+	 * Chunks are read in the order they were appended
+	 * @return the write of this chunk, completed once it is in the file
+	 */
+	FGraphEventRef AppendChunk(TArray<uint8>&& Chunk);
+
+	/** Appends the records not streamed yet and writes the slot file. Can run on any thread
+	 * @return true if the slot was saved
+	 */
+	bool Finish(USlotInfo* Info, USlotData* Data);
+
+private:
+
+	void WaitForWrites();
 };
 
 
@@ -96,11 +212,42 @@ class SAVEEXTENSION_API FFileAdapter
 public:
 
 	static bool SaveFile(FStringView SlotName, USlotInfo* Info, USlotData* Data, const bool bUseCompression);
+	/** Writes a file already serialized */
+	static bool SaveFile(FStringView SlotName, FSaveFile& File, const bool bUseCompression);
 
 	// Not safe for Multi-threading
 	static bool LoadFile(FStringView SlotName, USlotInfo*& Info, USlotData*& Data, bool bLoadData, const UObject* Outer);
 
+	/**
+	 * Reads a slot file, or finds it on the cache if it was read recently
+	 * @param bSkipData if true only the header is required
+	 * @return the file, or null if it could not be read
+	 */
+	static TSharedPtr<const FSaveFile> ReadFile(FStringView SlotName, bool bSkipData);
+
+	/** @return a recently read file if cached. Only if it includes its data, unless bSkipData */
+	static TSharedPtr<const FSaveFile> FindCachedFile(FStringView SlotName, bool bSkipData);
+	/** @return a counter increased every time a file is saved or deleted. See CacheFile */
+	static uint64 GetFileCacheGeneration();
+	/**
+	 * Keeps a read file in the cache if it fits in the budget. It is shared, so it must not change afterwards
+	 * @param ReadGeneration from GetFileCacheGeneration() before the file was read. If files were saved since, it may be outdated and is not cached
+	 */
+	static void CacheFile(FStringView SlotName, const TSharedRef<const FSaveFile>& File, bool bHasData, uint64 ReadGeneration);
+	/** Removes a file from the cache. Called before and after files are written or deleted */
+	static void UncacheFile(FStringView SlotName);
+	static void ClearFileCache();
+	/** Max bytes of files kept in the cache. 0 disables it */
+	static void SetFileCacheBudget(int64 Bytes);
+
 	static bool DeleteFile(FStringView SlotName);
+
+private:
+
+	/** Reads the header of a file from a small prefix read at once. @return false if it didn't fit */
+	static bool ReadHeaderPrefix(FStringView SlotName, FSaveFile& File);
+
+public:
 	static bool DoesFileExist(FStringView SlotName);
 
 	static const FString& GetSaveFolder();
@@ -108,4 +255,7 @@ public:
 	static FString GetThumbnailPath(FStringView SlotName);
 
 	static void DeserializeObject(UObject*& Object, FStringView ClassName, const UObject* Outer, const TArray<uint8>& Bytes);
+
+	/** Finds a class by path name, loading it if needed */
+	static UClass* FindObjectClass(FStringView ClassName);
 };
@@ -6,6 +6,7 @@
 #include <Engine/LatentActionManager.h>
 #include <LatentActions.h>
 
+#include "Misc/SlotIndex.h"
 #include "Multithreading/LoadSlotInfosTask.h"
 
 
@@ -50,3 +51,58 @@ public:
 	}
 #endif
 };
+
+/** FLoadSummariesAction */
+class FLoadSummariesAction : public FPendingLatentAction
+{
+
+public:
+	ELoadInfoResult& Result;
+
+	TArray<FSlotSummary>& Summaries;
+	bool bFinished;
+
+	FName ExecutionFunction;
+	int32 OutputLink;
+	FWeakObjectPtr CallbackTarget;
+
+
+	FLoadSummariesAction(USaveManager* Manager, const bool bSortByRecent, TArray<FSlotSummary>& Summaries, ELoadInfoResult& OutResult, const FLatentActionInfo& LatentInfo);
+
+	virtual void UpdateOperation(FLatentResponse& Response) override;
+
+#if WITH_EDITOR
+	virtual FString GetDescription() const override
+	{
+		return TEXT("Loading all summaries...");
+	}
+#endif
+};
+
+/** FQuerySlotsAction */
+class FQuerySlotsAction : public FPendingLatentAction
+{
+
+public:
+	ELoadInfoResult& Result;
+
+	TArray<FSlotSummary>& Page;
+	int32& NumMatches;
+	bool bFinished;
+
+	FName ExecutionFunction;
+	int32 OutputLink;
+	FWeakObjectPtr CallbackTarget;
+
+
+	FQuerySlotsAction(USaveManager* Manager, const FSlotQuery& Query, TArray<FSlotSummary>& Page, int32& NumMatches, ELoadInfoResult& OutResult, const FLatentActionInfo& LatentInfo);
+
+	virtual void UpdateOperation(FLatentResponse& Response) override;
+
+#if WITH_EDITOR
+	virtual FString GetDescription() const override
+	{
+		return TEXT("Querying slots...");
+	}
+#endif
+};
@@ -21,6 +21,7 @@ struct FSELevelFilter
 	static const FName TagNoPhysics;
 	static const FName TagNoTags;
 	static const FName TagTransform;
+	static const FName TagPooled;
 
 public:
 
@@ -62,7 +63,7 @@ public:
 
 	bool ShouldSave(const AActor* Actor) const
 	{
-		return ActorFilter.IsClassAllowed(Actor->GetClass());
+		return ActorFilter.IsClassAllowed(Actor->GetClass()) && !IsPooled(Actor);
 	}
 
 	bool ShouldLoad(const AActor* Actor) const
@@ -102,6 +103,7 @@ public:
 	static FORCEINLINE bool StoresPhysics(const AActor* Actor)   { return !HasTag(Actor, TagNoPhysics); }
 	static FORCEINLINE bool StoresTags(const AActor* Actor)      { return !HasTag(Actor, TagNoTags); }
 	static FORCEINLINE bool IsProcedural(const AActor* Actor)    { return Actor->HasAnyFlags(RF_WasLoaded | RF_LoadCompleted); }
+	static FORCEINLINE bool IsPooled(const AActor* Actor)        { return HasTag(Actor, TagPooled); }
 
 	static FORCEINLINE bool HasTag(const AActor* Actor, const FName Tag)
 	{
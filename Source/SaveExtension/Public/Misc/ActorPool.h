@@ -0,0 +1,57 @@
+// Copyright 2015-2020 Piperift. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <GameFramework/Actor.h>
+#include <Engine/Level.h>
+
+
+/**
+ * Keeps procedural actors that would be destroyed while loading so that they can be reused
+ * when actors of the same class have to be respawned.
+ * Pooled actors are hidden, have no collision or timers, don't tick and are ignored by save filters.
+ */
+struct SAVEEXTENSION_API FSEActorPool
+{
+private:
+
+	struct FPooledActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		/** Collision of the actor before it was pooled */
+		bool bCollisionEnabled = true;
+	};
+
+	TMap<const UClass*, TArray<FPooledActor>> Actors;
+
+
+public:
+
+	/**
+	 * Deactivates an actor and keeps it in the pool
+	 * @return false if the pool of this class is full. The actor is not modified then
+	 */
+	bool Release(AActor* Actor, int32 MaxPerClass);
+
+	/**
+	 * Takes a pooled actor of a class from a level and reactivates it.
+	 * An actor with the same name is preferred. Otherwise the actor gets renamed if possible.
+	 * @return the reused actor, or null if none was pooled
+	 */
+	AActor* Acquire(UClass* Class, const ULevel* Level, FName Name);
+
+	/** Forgets all pooled actors. They are not destroyed */
+	void Empty()
+	{
+		Actors.Empty();
+	}
+
+	/** Destroys all actors still pooled */
+	void DestroyAll();
+
+private:
+
+	static void Deactivate(AActor* Actor);
+	static void Reactivate(AActor* Actor, bool bCollisionEnabled);
+};
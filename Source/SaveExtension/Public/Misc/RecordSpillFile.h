@@ -0,0 +1,99 @@
+// Copyright 2015-2020 Piperift. All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <HAL/CriticalSection.h>
+#include <Templates/SharedPointer.h>
+#include <Templates/UniquePtr.h>
+
+class IFileHandle;
+
+
+/**
+ * Scratch file in the Saved folder where records evicted from memory are kept during a session.
+ * Bytes are written on a background thread, reusing the space of freed ones. The file is deleted when destroyed. Thread safe
+ */
+class SAVEEXTENSION_API FSERecordSpillFile : public TSharedFromThis<FSERecordSpillFile, ESPMode::ThreadSafe>
+{
+	struct FFreeRange
+	{
+		int64 Offset = 0;
+		int64 Size = 0;
+	};
+
+	FString Path;
+	TUniquePtr<IFileHandle> Handle;
+	/** End of the last used byte */
+	int64 Size = 0;
+	FCriticalSection FileLock;
+
+	/** Appended bytes not written yet, by offset. Read from here until written */
+	TMap<int64, TSharedRef<const TArray<uint8>, ESPMode::ThreadSafe>> PendingWrites;
+	/** Bytes freed before being written, by offset. Their space is reused once written */
+	TMap<int64, int32> FreedPendingWrites;
+	/** Space that can be reused, sorted by offset */
+	TArray<FFreeRange> FreeRanges;
+	FCriticalSection PendingLock;
+
+public:
+
+	FSERecordSpillFile();
+	~FSERecordSpillFile();
+
+	/** Deletes scratch files left by previous sessions that didn't shut down */
+	static void DeleteLeftovers();
+
+	/**
+	 * Queues bytes to be written on a background thread, in the first free space where they fit
+	 * @param Bytes are only moved if they can be written
+	 * @return offset where the bytes will be, or INDEX_NONE if they can't be written
+	 */
+	int64 Append(TArray<uint8>&& Bytes);
+
+	bool Read(int64 Offset, int32 Num, TArray<uint8>& OutBytes);
+
+	/** Marks appended bytes as not needed anymore, so that their space is reused */
+	void Free(int64 Offset, int32 Num);
+
+	int64 GetSize() const { return Size; }
+
+	bool HasPendingWrites();
+
+	static FString GetDirectory();
+
+private:
+
+	void Write(int64 Offset, const TArray<uint8>& Bytes);
+
+	/** @return offset of free space for some bytes. Only with PendingLock */
+	int64 Reserve(int64 Num);
+	/** Only with PendingLock */
+	void AddFreeRange(int64 Offset, int64 Num);
+};
+
+
+/** Bytes appended to a spill file. Their space is freed once no one refers to them */
+struct SAVEEXTENSION_API FSERecordSpillRange
+{
+	const TSharedRef<FSERecordSpillFile, ESPMode::ThreadSafe> File;
+	const int64 Offset;
+	const int32 Size;
+
+	FSERecordSpillRange(const TSharedRef<FSERecordSpillFile, ESPMode::ThreadSafe>& InFile, int64 InOffset, int32 InSize)
+		: File(InFile)
+		, Offset(InOffset)
+		, Size(InSize)
+	{}
+	~FSERecordSpillRange()
+	{
+		File->Free(Offset, Size);
+	}
+	FSERecordSpillRange(const FSERecordSpillRange&) = delete;
+	FSERecordSpillRange& operator=(const FSERecordSpillRange&) = delete;
+
+	bool Read(TArray<uint8>& OutBytes) const
+	{
+		return File->Read(Offset, Size, OutBytes);
+	}
+};
@@ -7,6 +7,9 @@
 
 #include "FileAdapter.h"
 
+class IImageWrapperModule;
+class UTexture2D;
+
 
 struct FSlotHelpers
 {
@@ -25,6 +28,17 @@ struct FSlotHelpers
 		virtual bool Visit(const TCHAR* FilenameOrDirectory, bool bIsDirectory) override;
 	};
 
+	/** Decodes a PNG or JPEG thumbnail into BGRA pixels. Can run on any thread */
+	static bool DecodeThumbnail(IImageWrapperModule& ImageWrapperModule, const TArray<uint8>& Image,
+		int32& OutWidth, int32& OutHeight, TArray64<uint8>& OutPixels);
+
+	/** Compresses thumbnail pixels as JPEG to be embedded in a file. Can run on any thread */
+	static bool EncodeThumbnail(IImageWrapperModule& ImageWrapperModule, int32 Width, int32 Height,
+		const TArray<FColor>& Pixels, TArray<uint8>& OutImage);
+
+	/** Creates a texture from decoded thumbnail pixels. Game thread only */
+	static UTexture2D* CreateThumbnailTexture(int32 Width, int32 Height, const TArray64<uint8>& Pixels);
+
 	static FString GetWorldName(const UWorld* World)
 	{
 		check(World);
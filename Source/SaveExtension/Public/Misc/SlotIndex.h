@@ -0,0 +1,97 @@
+// Copyright 2015-2020 Piperift. All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+
+#include "SlotInfo.h"
+
+#include "SlotIndex.generated.h"
+
+
+UENUM(BlueprintType)
+enum class ESlotSortKey : uint8
+{
+	SaveDate,
+	PlayedTime,
+	DisplayName,
+	FileName
+};
+
+/** Page of slots to find in the slot index */
+USTRUCT(BlueprintType)
+struct SAVEEXTENSION_API FSlotQuery
+{
+	GENERATED_BODY()
+
+	/** Number of matching slots skipped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SlotQuery, meta = (ClampMin = "0"))
+	int32 Offset = 0;
+
+	/** Maximum number of slots returned */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SlotQuery, meta = (ClampMin = "0"))
+	int32 Count = 20;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SlotQuery)
+	ESlotSortKey SortBy = ESlotSortKey::SaveDate;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SlotQuery)
+	bool bDescending = true;
+
+	/** If not none, only slots saved on this map are returned */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = SlotQuery)
+	FName Map;
+};
+
+
+/**
+ * Summaries of all slots on disk, kept in memory so that they can be queried by pages.
+ * Built once from disk and then updated as slots are saved or deleted.
+ */
+struct SAVEEXTENSION_API FSESlotIndex
+{
+private:
+
+	TArray<FSlotSummary> Summaries;
+	TMap<FName, int32> SlotIndices;
+	bool bBuilt = false;
+
+	/** Summary indices sorted by the last key queried */
+	mutable TArray<int32> SortedCache;
+	mutable ESlotSortKey CachedSortKey = ESlotSortKey::SaveDate;
+	mutable bool bCachedDescending = true;
+
+
+public:
+
+	/** Replaces all summaries. The index is built afterwards */
+	void Build(TArray<FSlotSummary> InSummaries);
+
+	/** Adds or replaces the summary of a slot. Ignored until the index is built */
+	void Update(const FSlotSummary& Summary);
+
+	void Remove(FName SlotName);
+
+	/** Forgets all summaries. The index has to be built again */
+	void Reset();
+
+	bool IsBuilt() const
+	{
+		return bBuilt;
+	}
+
+	int32 Num() const
+	{
+		return Summaries.Num();
+	}
+
+	/**
+	 * Finds a page of slots
+	 * @return the number of slots matching the query, ignoring offset and count
+	 */
+	int32 Query(const FSlotQuery& Query, TArray<FSlotSummary>& OutPage) const;
+
+private:
+
+	const TArray<int32>& GetSorted(ESlotSortKey SortBy, bool bDescending) const;
+};
@@ -0,0 +1,49 @@
+// Copyright 2015-2020 Piperift. All Rights Reserved.
+
+#pragma once
+
+#include <CoreMinimal.h>
+#include <Templates/SharedPointer.h>
+
+#include <atomic>
+
+class UWorld;
+
+
+/**
+ * Captures the game viewport into a small compressed image, without going through screenshots.
+ * Pixels are read back and downscaled on the render thread, then compressed on a worker.
+ * Poll IsDone() from the game thread.
+ */
+class SAVEEXTENSION_API FSEThumbnailCapture : public TSharedFromThis<FSEThumbnailCapture, ESPMode::ThreadSafe>
+{
+	int32 Width = 0;
+	int32 Height = 0;
+	TArray<uint8> Image;
+	std::atomic<bool> bDone{ false };
+
+public:
+
+	/** @return the capture in progress, or null if the world has no viewport to capture */
+	static TSharedPtr<FSEThumbnailCapture, ESPMode::ThreadSafe> Start(const UWorld* World, int32 Width, int32 Height);
+
+	bool IsDone() const
+	{
+		return bDone;
+	}
+
+	/** @return the compressed image. Empty if the capture failed. Only once IsDone() */
+	TArray<uint8> ConsumeImage()
+	{
+		check(IsDone());
+		return MoveTemp(Image);
+	}
+
+private:
+
+	void Finish(TArray<uint8>&& InImage)
+	{
+		Image = MoveTemp(InImage);
+		bDone = true;
+	}
+};
@@ -6,6 +6,13 @@
 
 
 DECLARE_DELEGATE_OneParam(FOnSlotInfosLoaded, const TArray<class USlotInfo*>&);
+DECLARE_DELEGATE_OneParam(FOnSlotSummariesLoaded, const TArray<struct FSlotSummary>&);
+// @param Page of slots found
+// @param Number of slots matching the query
+DECLARE_DELEGATE_TwoParams(FOnSlotsQueried, const TArray<struct FSlotSummary>&, int32);
+
+// @param Thumbnail of the slot. Null if it has none
+DECLARE_DELEGATE_OneParam(FOnThumbnailLoaded, class UTexture2D*);
 
 // @param Amount of slots removed
 DECLARE_DELEGATE(FOnSlotsDeleted);
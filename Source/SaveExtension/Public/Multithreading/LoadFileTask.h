@@ -3,12 +3,15 @@
 #pragma once
 
 #include <Async/AsyncWork.h>
+#include <atomic>
 #include "FileAdapter.h"
+#include "SlotData.h"
 
 
 /////////////////////////////////////////////////////
 // FLoadFileTask
-// Async task to load a File
+// Async task to load a File.
+// Records are decoded into plain structs. The data object is created on the game thread by GetData()
 class FLoadFileTask : public FNonAbandonableTask
 {
 protected:
@@ -16,22 +19,56 @@ protected:
 	TWeakObjectPtr<USaveManager> Manager;
 	const FString SlotName;
 
-	TWeakObjectPtr<USlotInfo> SlotInfo;
+	/** If true, the file is only read. Its objects can be created later by another task */
+	const bool bOnlyRead = false;
+
+	/** File read by the task, or kept by someone else like a snapshot or the file cache */
+	TSharedPtr<const FSaveFile> SharedFile;
+	std::atomic<bool> bHeaderRead { false };
+
+	/** Records decoded by the task. Only moved into the data once it is created, if decoded successfully */
+	FSlotDataRecords Records;
+	bool bRecordsDecoded = false;
+
+	/** A record whose class or data can't be loaded */
+	struct FInvalidRecord
+	{
+		/** INDEX_NONE for the main level */
+		int32 LevelIndex = INDEX_NONE;
+		/** INDEX_NONE for the level script */
+		int32 ActorIndex = INDEX_NONE;
+		/** INDEX_NONE if the actor itself is invalid */
+		int32 ComponentIndex = INDEX_NONE;
+	};
+
+	/** If true, decoded records are validated on worker threads. See SetValidateRecords */
+	bool bValidateRecords = false;
+
+	/** Invalid records found by each validation batch. Applied to the records by GetData() */
+	TArray<TArray<FInvalidRecord>> InvalidRecords;
+
 	TWeakObjectPtr<USlotData> SlotData;
 
+	/** If set, data is deserialized into this object instead of a new one */
+	TWeakObjectPtr<USlotData> ReusedData;
+
 
 public:
 
-	explicit FLoadFileTask(USaveManager* Manager, FStringView SlotName)
+	explicit FLoadFileTask(USaveManager* Manager, FStringView SlotName, bool bOnlyRead = false)
 		: Manager(Manager)
 		, SlotName(SlotName)
+		, bOnlyRead(bOnlyRead)
+	{}
+	/** Only creates the objects of a file shared with other owners. The file is not copied */
+	explicit FLoadFileTask(USaveManager* Manager, TSharedPtr<const FSaveFile> InFile)
+		: Manager(Manager)
+		, SharedFile(MoveTemp(InFile))
+		, bHeaderRead(true)
 	{}
 	~FLoadFileTask()
 	{
-		if(SlotInfo.IsValid())
-		{
-			SlotInfo->ClearInternalFlags(EInternalObjectFlags::Async);
-		}
+		// Only data of older files is created by the task
 		if(SlotData.IsValid())
 		{
 			SlotData->ClearInternalFlags(EInternalObjectFlags::Async);
@@ -40,23 +77,118 @@ public:
 
 	void DoWork()
 	{
-		FScopedFileReader FileReader(FFileAdapter::GetSlotPath(SlotName));
-		if(FileReader.IsValid())
+		if (!SlotName.IsEmpty())
 		{
-			FSaveFile File;
-			File.Read(FileReader, false);
-			SlotInfo = File.CreateAndDeserializeInfo(Manager.Get());
-			SlotData = File.CreateAndDeserializeData(Manager.Get());
+			SharedFile = FFileAdapter::FindCachedFile(SlotName, false);
+			if (SharedFile)
+			{
+				bHeaderRead = true;
+			}
+			else
+			{
+				const uint64 Generation = FFileAdapter::GetFileCacheGeneration();
+				FScopedFileReader FileReader(FFileAdapter::GetSlotPath(SlotName));
+				if(!FileReader.IsValid())
+				{
+					return;
+				}
+
+				// Shared before reading the data, so that the header can be accessed meanwhile
+				TSharedRef<FSaveFile> File = MakeShared<FSaveFile>();
+				const bool bHasData = File->ReadHeader(FileReader);
+				SharedFile = File;
+				bHeaderRead = true;
+				if (bHasData)
+				{
+					File->ReadData(FileReader);
+				}
+				FFileAdapter::CacheFile(SlotName, File, true, Generation);
+			}
 		}
+
+		if (!bOnlyRead && SharedFile)
+		{
+			const FSaveFile& Source = *SharedFile;
+			if (Source.HasRecordBytes())
+			{
+				bRecordsDecoded = Source.DeserializeRecords(Records);
+				if (bRecordsDecoded && bValidateRecords)
+				{
+					ValidateRecords();
+				}
+			}
+			// Older files keep records inside the data object, so it has to be created here
+			else if (ReusedData.IsValid() && Source.DeserializeData(ReusedData.Get()))
+			{
+				SlotData = ReusedData;
+			}
+			else
+			{
+				SlotData = Source.CreateAndDeserializeData(Manager.Get());
+			}
+		}
+	}
+
+	/** Deserialize data into an existing object. Must be called before the task starts.
+	 * Its records are only replaced once the file was decoded, so they stay valid if loading fails
+	 */
+	void SetReusedData(USlotData* Data)
+	{
+		ReusedData = Data;
 	}
 
-	USlotInfo* GetInfo()
+	/** Validate decoded records on worker threads, so that the loader doesn't apply records it can't read.
+	 * Sub-levels kept encoded are not validated. Must be called before the task starts
+	 */
+	void SetValidateRecords(bool bValue)
 	{
-		return SlotInfo.Get();
+		bValidateRecords = bValue;
 	}
 
+	/** @return true once the header of the file is available, even if the task didn't finish */
+	bool IsHeaderRead() const
+	{
+		return bHeaderRead;
+	}
+
+	/** File being read. Only its header is valid before the task is done, if IsHeaderRead() */
+	const FSaveFile& GetHeader() const
+	{
+		check(IsHeaderRead());
+		return *SharedFile;
+	}
+
+	/** Classes and assets the data references. Only valid if IsHeaderRead() */
+	const TArray<FSoftObjectPath>& GetReferences() const
+	{
+		return GetHeader().References;
+	}
+
+	/** @return the file read. Only safe to access once the task is done */
+	const TSharedPtr<const FSaveFile>& GetSharedFile() const
+	{
+		return SharedFile;
+	}
+
+	/** Creates the data from the decoded records if needed. Only call from the game thread once the task is done */
 	USlotData* GetData()
 	{
+		if (bRecordsDecoded && !SlotData.IsValid() && SharedFile)
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(FLoadFileTask::GetData);
+			bRecordsDecoded = false;
+			DiscardInvalidRecords();
+
+			const FSaveFile& Source = *SharedFile;
+			if (ReusedData.IsValid() && Source.DeserializeData(ReusedData.Get(), &Records))
+			{
+				SlotData = ReusedData;
+			}
+			else
+			{
+				SlotData = Source.CreateAndDeserializeData(Manager.Get(), &Records);
+			}
+		}
 		return SlotData.Get();
 	}
 
@@ -64,4 +196,12 @@ public:
 	{
 		RETURN_QUICK_DECLARE_CYCLE_STAT(FLoadFileTask, STATGROUP_ThreadPoolAsyncTasks);
 	}
+
+protected:
+
+	/** Checks the classes of decoded actor and component records and that their data can be read. Runs in parallel batches */
+	void ValidateRecords();
+
+	/** Clears the data of records found invalid, so that they are not applied */
+	void DiscardInvalidRecords();
 };
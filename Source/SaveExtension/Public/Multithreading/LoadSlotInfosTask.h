@@ -13,7 +13,8 @@ class USaveManager;
 
 /**
  * FLoadSlotInfosTask
- * Async task to load one or many slot infos
+ * Async task to load one or many slot infos.
+ * Files are read on the task, infos are created on the game thread by CreateInfos()
  */
 class FLoadSlotInfosTask : public FNonAbandonableTask
 {
@@ -25,6 +26,8 @@ protected:
 	// If not empty, only this specific slot will be loaded
 	const FName SlotName;
 
+	/** Read files, sorted */
+	TArray<TSharedPtr<const FSaveFile>> LoadedFiles;
 	TArray<USlotInfo*> LoadedSlots;
 
 	FOnSlotInfosLoaded Delegate;
@@ -50,6 +53,9 @@ public:
 	/** Called after the task has finished */
 	void AfterFinish();
 
+	/** Creates the infos of the files read. Only call from the game thread once the task is done */
+	void CreateInfos();
+
 	const TArray<USlotInfo*>& GetLoadedSlots() const
 	{
 		return LoadedSlots;
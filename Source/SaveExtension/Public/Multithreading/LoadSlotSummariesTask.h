@@ -0,0 +1,66 @@
+// Copyright 2015-2020 Piperift. All Rights Reserved.
+
+#pragma once
+
+#include <Async/AsyncWork.h>
+#include "FileAdapter.h"
+#include "Multithreading/Delegates.h"
+
+#include "SlotInfo.h"
+
+class USaveManager;
+
+
+/**
+ * FLoadSlotSummariesTask
+ * Async task to read the summaries of one or many slots.
+ * Infos are only created for files saved before summaries were added
+ */
+class FLoadSlotSummariesTask : public FNonAbandonableTask
+{
+protected:
+
+	const USaveManager* Manager;
+
+	const bool bSortByRecent = false;
+	// If not empty, only this specific slot will be loaded
+	const FName SlotName;
+
+	TArray<FSlotSummary> Summaries;
+
+	/** Infos created to read the summary of older files */
+	TArray<USlotInfo*> LegacyInfos;
+
+	FOnSlotSummariesLoaded Delegate;
+
+
+public:
+
+	/** All summaries Constructor */
+	explicit FLoadSlotSummariesTask(const USaveManager* Manager, bool bInSortByRecent, const FOnSlotSummariesLoaded& Delegate)
+		: Manager(Manager)
+		, bSortByRecent(bInSortByRecent)
+		, Delegate(Delegate)
+	{}
+
+	/** One summary Constructor */
+	explicit FLoadSlotSummariesTask(const USaveManager* Manager, FName SlotName)
+		: Manager(Manager)
+		, SlotName(SlotName)
+	{}
+
+	void DoWork();
+
+	/** Called after the task has finished */
+	void AfterFinish();
+
+	const TArray<FSlotSummary>& GetSummaries() const
+	{
+		return Summaries;
+	}
+
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FLoadSlotSummariesTask, STATGROUP_ThreadPoolAsyncTasks);
+	}
+};
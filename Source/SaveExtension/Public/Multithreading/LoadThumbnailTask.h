@@ -0,0 +1,82 @@
+// Copyright 2015-2020 Piperift. All Rights Reserved.
+
+#pragma once
+
+#include <Async/AsyncWork.h>
+#include <HAL/FileManager.h>
+#include <IImageWrapperModule.h>
+#include <Misc/FileHelper.h>
+
+#include "FileAdapter.h"
+#include "Misc/SlotHelpers.h"
+
+
+/////////////////////////////////////////////////////
+// FLoadThumbnailTask
+// Async task to read and decode the thumbnail of a slot, embedded or as an image file.
+// Its texture is created later on the game thread
+class FLoadThumbnailTask : public FNonAbandonableTask
+{
+public:
+
+	const FName SlotName;
+	/** Modification time of a thumbnail already cached. It is not decoded again if it matches */
+	const FDateTime CachedTimeStamp;
+
+	IImageWrapperModule& ImageWrapperModule;
+
+	FDateTime TimeStamp;
+	bool bUnchanged = false;
+
+	int32 Width = 0;
+	int32 Height = 0;
+	TArray64<uint8> Pixels;
+
+
+	/** ImageWrapperModule has to be loaded from the game thread */
+	explicit FLoadThumbnailTask(FName SlotName, FDateTime CachedTimeStamp, IImageWrapperModule& ImageWrapperModule)
+		: SlotName(SlotName)
+		, CachedTimeStamp(CachedTimeStamp)
+		, ImageWrapperModule(ImageWrapperModule)
+	{}
+
+	void DoWork()
+	{
+		const FString SlotNameStr = SlotName.ToString();
+		const FString Path = FFileAdapter::GetThumbnailPath(SlotNameStr);
+
+		// Embedded thumbnails change with their slot file
+		IFileManager& FileManager = IFileManager::Get();
+		TimeStamp = FMath::Max(FileManager.GetTimeStamp(*FFileAdapter::GetSlotPath(SlotNameStr)), FileManager.GetTimeStamp(*Path));
+		if (TimeStamp == FDateTime::MinValue())
+		{
+			// No thumbnail
+			return;
+		}
+		if (TimeStamp == CachedTimeStamp)
+		{
+			bUnchanged = true;
+			return;
+		}
+
+		TArray<uint8> Image;
+		if (TSharedPtr<const FSaveFile> File = FFileAdapter::ReadFile(SlotNameStr, true))
+		{
+			Image = File->ThumbnailBytes;
+		}
+		if (Image.Num() <= 0)
+		{
+			FFileHelper::LoadFileToArray(Image, *Path, FILEREAD_Silent);
+		}
+
+		if (Image.Num() <= 0 || !FSlotHelpers::DecodeThumbnail(ImageWrapperModule, Image, Width, Height, Pixels))
+		{
+			Pixels.Empty();
+		}
+	}
+
+	FORCEINLINE TStatId GetStatId() const
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(FLoadThumbnailTask, STATGROUP_ThreadPoolAsyncTasks);
+	}
+};
@@ -12,10 +12,15 @@
 class FSaveFileTask : public FNonAbandonableTask {
 protected:
 
-	USlotInfo* Info;
-	USlotData* Data;
+	USlotInfo* Info = nullptr;
+	USlotData* Data = nullptr;
+	/** Already serialized file. Used if Info and Data are not provided */
+	FSaveFile File;
+	/** Stream whose records were already written. Used instead of serializing Data if provided */
+	TUniquePtr<FSaveFileStream> Stream;
 	const FString SlotName;
 	const bool bUseCompression;
+	bool bSaved = false;
 
 public:
 
@@ -26,11 +31,40 @@ public:
 		bUseCompression(bInUseCompression)
 	{}
 
+	FSaveFileTask(FSaveFile&& InFile, const FString& InSlotName, const bool bInUseCompression) :
+		File(MoveTemp(InFile)),
+		SlotName(InSlotName),
+		bUseCompression(bInUseCompression)
+	{}
+
+	FSaveFileTask(TUniquePtr<FSaveFileStream>&& InStream, USlotInfo* Info, USlotData* Data, const FString& InSlotName) :
+		Info(Info),
+		Data(Data),
+		Stream(MoveTemp(InStream)),
+		SlotName(InSlotName),
+		bUseCompression(Stream->IsCompressed())
+	{}
+
 	void DoWork()
 	{
-		FFileAdapter::SaveFile(SlotName, Info, Data, bUseCompression);
+		if (Stream)
+		{
+			bSaved = Stream->Finish(Info, Data);
+			Stream.Reset();
+		}
+		else if (Info || Data)
+		{
+			bSaved = FFileAdapter::SaveFile(SlotName, Info, Data, bUseCompression);
+		}
+		else
+		{
+			bSaved = FFileAdapter::SaveFile(SlotName, File, bUseCompression);
+		}
 	}
 
+	/** @return true once the file was written */
+	bool IsSaved() const { return bSaved; }
+
 	FORCEINLINE TStatId GetStatId() const
 	{
 		RETURN_QUICK_DECLARE_CYCLE_STAT(FSaveFileTask, STATGROUP_ThreadPoolAsyncTasks);
@@ -3,10 +3,14 @@
 #pragma once
 
 #include "Delegates.h"
+#include "FileAdapter.h"
 #include "LatentActions/DeleteSlotsAction.h"
 #include "LatentActions/LoadGameAction.h"
 #include "LatentActions/SaveGameAction.h"
 #include "LevelStreamingNotifier.h"
+#include "Misc/ActorPool.h"
+#include "Misc/RecordSpillFile.h"
+#include "Misc/SlotIndex.h"
 #include "Multithreading/ScopedTaskManager.h"
 #include "Multithreading/Delegates.h"
 #include "SaveExtensionInterface.h"
@@ -15,9 +19,11 @@
 #include "SlotData.h"
 #include "SlotInfo.h"
 
+#include <Algo/Count.h>
 #include <Async/AsyncWork.h>
 #include <CoreMinimal.h>
 #include <Engine/GameInstance.h>
+#include <Engine/StreamableManager.h>
 #include <GenericPlatform/GenericPlatformFile.h>
 #include <HAL/PlatformFilemanager.h>
 #include <Subsystems/GameInstanceSubsystem.h>
@@ -28,10 +34,33 @@
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGameSavedMC, USlotInfo*, SlotInfo);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnGameLoadedMC, USlotInfo*, SlotInfo);
+DECLARE_DYNAMIC_DELEGATE_OneParam(FOnThumbnailLoadedDynamic, UTexture2D*, Thumbnail);
 
 
 struct FLatentActionInfo;
 
+UENUM(BlueprintType)
+enum class EEmergencySaveResult : uint8
+{
+	Saved,
+	// Saved, but it took longer than the deadline of the preset
+	SavedLate,
+	Failed
+};
+
+/** Thumbnail texture cached by slot and modification time of its file */
+USTRUCT()
+struct FSEThumbnailCacheEntry
+{
+	GENERATED_BODY()
+
+	FName SlotName;
+	FDateTime TimeStamp;
+
+	UPROPERTY()
+	UTexture2D* Texture = nullptr;
+};
+
 USTRUCT(BlueprintType)
 struct FScreenshotSize
 {
@@ -92,9 +121,50 @@ private:
 	UPROPERTY(Transient)
 	TArray<TScriptInterface<ISaveExtensionInterface>> SubscribedInterfaces;
 
+	/** Running and pending tasks, in the order they were created.
+	 * A task starts once no previous task accesses the same records. See USlotDataTask::GetAccess
+	 */
 	UPROPERTY(Transient)
 	TArray<USlotDataTask*> Tasks;
 
+	bool bStartingTasks = false;
+	bool bRestartReadyTasks = false;
+
+	/** Procedural actors kept while loading to be reused. See USavePreset::bUseActorPool */
+	FSEActorPool ActorPool;
+
+	/** Loads classes and assets referenced by slots before they are deserialized */
+	FStreamableManager StreamableManager;
+
+	/** Scratch file where records of hidden sub-levels are moved. See TrimSubLevelRecords */
+	TSharedPtr<FSERecordSpillFile, ESPMode::ThreadSafe> RecordSpillFile;
+
+	/** Serialized slots kept in memory by CaptureSnapshot. Newest last */
+	TArray<TSharedPtr<const FSaveFile>> Snapshots;
+
+	/** Recently requested thumbnails. Most recent last. See RequestThumbnail */
+	UPROPERTY(Transient)
+	TArray<FSEThumbnailCacheEntry> ThumbnailCache;
+
+	/** Thumbnail requests being read, by slot */
+	TMap<FName, TArray<FOnThumbnailLoaded>> PendingThumbnails;
+
+	/** Summaries of all slots, built on the first query. See QuerySlots */
+	FSESlotIndex SlotIndex;
+	bool bBuildingSlotIndex = false;
+	/** Queries waiting for the slot index to be built */
+	TArray<TPair<FSlotQuery, FOnSlotsQueried>> PendingSlotQueries;
+	/** Slots saved or deleted while the index is built, applied after it. Unset if deleted */
+	TMap<FName, TOptional<FSlotSummary>> PendingSlotIndexChanges;
+
+	/** Seconds since the last autosave */
+	float AutoSaveTime = 0.f;
+	/** Next autosave slot. The oldest one is found on the first autosave */
+	int32 NextAutoSaveIndex = INDEX_NONE;
+	/** Moving averages of recent and older frame times, to find frames with low load */
+	float RecentFrameTime = 0.f;
+	float AverageFrameTime = 0.f;
+
 
 	/************************************************************************/
 	/* METHODS											     			    */
@@ -131,8 +201,30 @@ public:
 	/** Save the currently loaded Slot */
 	bool SaveCurrentSlot(bool bScreenshot = false, const FScreenshotSize Size = {}, FOnGameSaved OnSaved = {});
 
+	/**
+	 * Save the Game synchronously, as fast as possible. Used when the game closes.
+	 * Serializes using all cores, without compression or thumbnail. Saves waiting to start are cancelled.
+	 * @param SlotName to save into. By default the current slot, or the first autosave slot if none
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveExtension|Saving", meta = (UnsafeDuringActorConstruction))
+	EEmergencySaveResult EmergencySave(FName SlotName = NAME_None);
 
-	/** Load game from a file name */
+	/** Save the game into the next autosave slot, overriding the oldest one. Resets the autosave interval */
+	UFUNCTION(BlueprintCallable, Category = "SaveExtension|Saving", meta = (UnsafeDuringActorConstruction))
+	bool AutoSave();
+
+	/**
+	 * Cancel saves that didn't start yet. Their delegates are notified as failed
+	 * @param SlotName only saves to this slot are cancelled. All if None
+	 * @return the number of saves cancelled
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveExtension|Saving")
+	int32 CancelPendingSaves(FName SlotName = NAME_None);
+
+
+	/** Load game from a file name.
+	 * The file is only read asynchronously. If the slot doesn't exist, OnLoaded receives null
+	 */
 	bool LoadSlot(FName SlotName, FOnGameLoaded OnLoaded = {});
 
 	/** Load game from a slot Id */
@@ -155,6 +247,23 @@ public:
 	void LoadAllSlotInfos(bool bSortByRecent, FOnSlotInfosLoaded Delegate);
 	void LoadAllSlotInfosSync(bool bSortByRecent, FOnSlotInfosLoaded Delegate);
 
+	/**
+	 * Find all saved games and return their summaries.
+	 * Unlike LoadAllSlotInfos, no objects are created. Use LoadInfo to get the info of a summary
+	 * @param bSortByRecent Should slots be ordered by save date?
+	 */
+	void LoadAllSlotSummaries(bool bSortByRecent, FOnSlotSummariesLoaded Delegate);
+	void LoadAllSlotSummariesSync(bool bSortByRecent, FOnSlotSummariesLoaded Delegate);
+
+	/**
+	 * Find a page of slots, sorted and filtered, from an index kept in memory.
+	 * The index is built from disk on the first query, later queries are answered immediately.
+	 */
+	void QuerySlots(const FSlotQuery& Query, FOnSlotsQueried Delegate);
+
+	/** Read all summaries from disk again. Only needed if slot files were modified externally */
+	void RefreshSlotIndex();
+
 	/** Delete a saved game on an specified slot name
 	 * Performance: Interacts with disk, can be slow
 	 */
@@ -163,6 +272,19 @@ public:
 	/** Delete all saved slots from disk, loaded or not */
 	void DeleteAllSlots(FOnSlotsDeleted Delegate);
 
+	/**
+	 * Save the Game into memory. Snapshots are restored without touching disk.
+	 * Only the last MaxSnapshots of the preset are kept.
+	 * @param bFlushToDisk if true, the snapshot is also saved to the current slot
+	 */
+	bool CaptureSnapshot(bool bFlushToDisk = false, FOnGameSaved OnSaved = {});
+
+	/**
+	 * Load game from a snapshot
+	 * @param Index of the snapshot, 0 being the most recent
+	 */
+	bool RestoreSnapshot(int32 Index = 0, FOnGameLoaded OnLoaded = {});
+
 
 	/** BLUEPRINT ONLY API */
 public:
@@ -231,6 +353,28 @@ public:
 	void BPLoadAllSlotInfos(const bool bSortByRecent, TArray<USlotInfo*>& SaveInfos, ELoadInfoResult& Result,
 		struct FLatentActionInfo LatentInfo);
 
+	/**
+	 * Find all saved games and return their summaries, without creating their SlotInfos
+	 * @param bSortByRecent Should slots be ordered by save date?
+	 * @param Summaries All saved games found on disk
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveExtension",
+		meta = (Latent, LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Result",
+			DisplayName = "Load All Slot Summaries"))
+	void BPLoadAllSlotSummaries(const bool bSortByRecent, TArray<FSlotSummary>& Summaries, ELoadInfoResult& Result,
+		struct FLatentActionInfo LatentInfo);
+
+	/**
+	 * Find a page of slots from the slot index. Meant for UI listing many slots
+	 * @param Page Slots found, at most Query.Count
+	 * @param NumMatches Slots matching the query, ignoring its offset and count
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveExtension",
+		meta = (Latent, LatentInfo = "LatentInfo", ExpandEnumAsExecs = "Result",
+			DisplayName = "Query Slots"))
+	void BPQuerySlots(FSlotQuery Query, TArray<FSlotSummary>& Page, int32& NumMatches, ELoadInfoResult& Result,
+		struct FLatentActionInfo LatentInfo);
+
 	/** Delete a saved game on an specified slot Id
 	 * Performance: Interacts with disk, can be slow
 	 */
@@ -250,6 +394,26 @@ public:
 			DisplayName = "Delete All Slots"))
 	void BPDeleteAllSlots(EDeleteSlotsResult& Result, FLatentActionInfo LatentInfo);
 
+	/** Save the Game into memory. OnGameSaved is called when done
+	 * @param bFlushToDisk if true, the snapshot is also saved to the current slot
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveExtension|Snapshots",
+		meta = (DisplayName = "Capture Snapshot", UnsafeDuringActorConstruction))
+	bool BPCaptureSnapshot(bool bFlushToDisk = false)
+	{
+		return CaptureSnapshot(bFlushToDisk);
+	}
+
+	/** Load game from a snapshot. OnGameLoaded is called when done
+	 * @param Index of the snapshot, 0 being the most recent
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveExtension|Snapshots",
+		meta = (DisplayName = "Restore Snapshot", UnsafeDuringActorConstruction))
+	bool BPRestoreSnapshot(int32 Index = 0)
+	{
+		return RestoreSnapshot(Index);
+	}
+
 	UFUNCTION(BlueprintPure, Category = "SaveExtension")
 	USavePreset* BPGetPreset() const
 	{
@@ -303,6 +467,39 @@ public:
 		return LoadInfo(SlotName);
 	}
 
+	/**
+	 * Read the summary of a slot without creating its SlotInfo
+	 * Performance: Interacts with disk, could be slow if called frequently
+	 * @return true if the slot exists
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SaveExtension|Slots")
+	bool GetSlotSummary(FName SlotName, FSlotSummary& Summary);
+
+	/**
+	 * Load the thumbnail of a slot. It is read and decoded on another thread and then cached.
+	 * Cached thumbnails are only decoded again if their file changed
+	 * @param OnLoaded receives null if the slot has no thumbnail
+	 */
+	void RequestThumbnail(FName SlotName, FOnThumbnailLoaded OnLoaded);
+
+	UFUNCTION(BlueprintCallable, Category = "SaveExtension|Slots", meta = (DisplayName = "Request Thumbnail"))
+	void BPRequestThumbnail(FName SlotName, const FOnThumbnailLoadedDynamic& OnLoaded)
+	{
+		RequestThumbnail(SlotName, FOnThumbnailLoaded::CreateWeakLambda(this, [OnLoaded](UTexture2D* Thumbnail) {
+			OnLoaded.ExecuteIfBound(Thumbnail);
+		}));
+	}
+
+	/** @return the cached thumbnail of a slot if any, without checking if its file changed */
+	UFUNCTION(BlueprintPure, Category = "SaveExtension|Slots")
+	UTexture2D* FindCachedThumbnail(FName SlotName) const;
+
+	UFUNCTION(BlueprintCallable, Category = "SaveExtension|Slots")
+	void ClearThumbnailCache()
+	{
+		ThumbnailCache.Empty();
+	}
+
 	/** Check if an slot exists on disk
 	 * @return true if the slot exists
 	 */
@@ -318,6 +515,19 @@ public:
 		return IsValidSlot(SlotId)? IsSlotSaved(GetSlotNameFromId(SlotId)) : false;
 	}
 
+	UFUNCTION(BlueprintPure, Category = "SaveExtension|Snapshots")
+	int32 GetNumSnapshots() const
+	{
+		return Snapshots.Num();
+	}
+
+	/** Discard all snapshots kept in memory */
+	UFUNCTION(BlueprintCallable, Category = "SaveExtension|Snapshots")
+	void ClearSnapshots()
+	{
+		Snapshots.Empty();
+	}
+
 	/** Check if currently playing in a saved slot
 	 * @return true if currently playing in a saved slot
 	 */
@@ -353,6 +563,44 @@ public:
 		CurrentData = NewData;
 	}
 
+	void __AddSnapshot(FSaveFile&& File);
+
+	/** Called when a slot is written to keep the slot index up to date */
+	void __UpdateSlotIndex(const FSlotSummary& Summary)
+	{
+		if (bBuildingSlotIndex)
+		{
+			// Summaries being read may be older
+			PendingSlotIndexChanges.Add(Summary.FileName, Summary);
+			return;
+		}
+		SlotIndex.Update(Summary);
+	}
+
+	/** Moves records of hidden sub-levels to disk while they exceed USavePreset::SubLevelRecordsBudgetMB.
+	 * Must only run while no task uses records. See ScheduleSubLevelRecordsTrim
+	 */
+	void TrimSubLevelRecords();
+
+	/** Trims sub-level records once running tasks finish, if a budget is set */
+	void ScheduleSubLevelRecordsTrim();
+
+	/** @return a snapshot by index, 0 being the most recent */
+	TSharedPtr<const FSaveFile> GetSnapshot(int32 Index) const
+	{
+		return Snapshots.IsValidIndex(Index) ? Snapshots.Last(Index) : nullptr;
+	}
+
+	FSEActorPool& GetActorPool()
+	{
+		return ActorPool;
+	}
+
+	FStreamableManager& GetStreamableManager()
+	{
+		return StreamableManager;
+	}
+
 	USlotInfo* LoadInfo(FName SlotName);
 	USlotInfo* LoadInfo(uint32 SlotId)
 	{
@@ -384,12 +632,41 @@ private:
 
 	void FinishTask(USlotDataTask* Task);
 
+	/** Autosaves once the interval passed, on the first frame with low load */
+	void UpdateAutoSave(float DeltaTime);
+
+	/** @return the index of the autosave slot saved longest ago, or never */
+	int32 FindOldestAutoSave() const;
+
+	/**
+	 * Finds a save to a slot that didn't start yet and new requests can be merged into.
+	 * Never skips over other tasks, since merging would change the order of both.
+	 */
+	class USlotDataTask_Saver* FindPendingSave(FName SlotName) const;
+
+	/** @return true if no previous task conflicts with this one */
+	bool CanStartTask(const USlotDataTask* Task) const;
+
+	/** Runs all tasks to completion on this frame, in order. @return false if one couldn't finish */
+	bool FinishAllTasks();
+
+	/** Starts all pending tasks that don't conflict with previous ones */
+	void StartReadyTasks();
+
 public:
 	bool HasTasks() const
 	{
 		return Tasks.Num() > 0;
 	}
 
+	/** @return number of tasks waiting for previous ones accessing the same records */
+	int32 GetNumWaitingTasks() const
+	{
+		return Algo::CountIf(Tasks, [](const USlotDataTask* Task) {
+			return !Task->IsRunning() && !Task->IsFinished();
+		});
+	}
+
 	/** @return true when saving or loading anything, including levels */
 	UFUNCTION(BlueprintPure, Category = SaveExtension)
 	bool IsSavingOrLoading() const
@@ -51,18 +51,36 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Gameplay, meta = (ClampMin = "0"))
 	int32 MaxSlots = 0;
 
-	/** If checked, will attempt to Save Game to first Slot found, timed event. */
+	/** Maximum amount of snapshots kept in memory. The oldest one is discarded when capturing more */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Gameplay, meta = (ClampMin = "0", UIMax = "16"))
+	int32 MaxSnapshots = 3;
+
+	/** If checked, the game is saved every AutoSaveInterval seconds into the autosave slots */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
-	bool bAutoSave = true;
+	bool bAutoSave = false;
 
 	/** Interval in seconds for auto saving */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay, meta = (EditCondition = "bAutoSave", UIMin = "15", UIMax = "3600"))
 	int32 AutoSaveInterval = 120.f;
 
-	/** If checked, will attempt to Save Game to first Slot found, timed event. */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay, meta = (EditCondition = "bAutoSave"))
+	/** Max seconds an autosave can wait after its interval for a frame with low load.
+	 * Frames have low load when nothing is being saved, loaded or streamed and frame times are not above average.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay, AdvancedDisplay, meta = (EditCondition = "bAutoSave", ClampMin = "0", UIMax = "60"))
+	float AutoSaveMaxDelay = 10.f;
+
+	/** Autosaves rotate between this amount of slots, overriding the oldest one each time */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay, meta = (EditCondition = "bAutoSave", ClampMin = "1", UIMax = "10"))
+	int32 AutoSaveSlots = 1;
+
+	/** If checked, the current slot is saved synchronously when the game closes. See USaveManager::EmergencySave */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
 	bool bSaveOnExit = false;
 
+	/** Seconds an emergency save is expected to take. Slower saves are reported as late */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay, AdvancedDisplay, meta = (ClampMin = "0"))
+	float EmergencySaveDeadline = 2.f;
+
 	/** If checked, will attempt to Load Game from last Slot found, when game starts */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Gameplay)
 	bool bAutoLoad = true;
@@ -92,6 +110,27 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Serialization)
 	bool bStoreGameInstance = true;
 
+	/** If true, thumbnails are stored compressed inside the save file instead of as separate images.
+	 * They are read along with the info, and captured without a high resolution screenshot.
+	 * Keep their size small, since listing slots also reads them
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Serialization)
+	bool bEmbedThumbnails = false;
+
+	/** If true, loads deserialize into the current SlotData instead of creating a new one.
+	 * Records of the last load are kept until the next one decodes its file successfully.
+	 * Performance: Avoids creating a data object and its garbage on each load. Records stay in memory between loads
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Serialization, AdvancedDisplay)
+	bool bReuseSlotData = false;
+
+	/** If true, actor records are compressed and written to disk while they are serialized, instead of kept until the end.
+	 * Performance: Peak memory of saving stays close to a few batches of actors instead of the whole world.
+	 * Disk writes can happen during serialization. Snapshots are not streamed
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Serialization, AdvancedDisplay)
+	bool bStreamRecords = false;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serialization|Actors")
 	FSEActorClassFilter ActorFilter;
 
@@ -102,6 +141,28 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serialization|Actors", meta = (EditCondition="bUseLoadActorFilter"))
 	FSEActorClassFilter LoadActorFilter;
 
+	/** If true, respawned actors get their saved state before construction scripts and BeginPlay run.
+	 * All actors of a level are then finished spawning together (in small batches on frame split loads).
+	 * Otherwise actors spawn completely and get deserialized afterwards, possibly undoing their construction.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serialization|Actors", AdvancedDisplay)
+	bool bDeferRespawnConstruction = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serialization|Actors", meta = (PinHiddenByDefault, InlineEditConditionToggle))
+	bool bUseActorPool = false;
+
+	/** If enabled, procedural actors of these classes are pooled instead of destroyed while loading
+	 * and reused when actors of the same class have to be respawned.
+	 * Reused actors don't run their construction or BeginPlay again. Their state is reset by deserialization.
+	 * Pooled actors not reused by the end of the load are destroyed.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serialization|Actors", AdvancedDisplay, meta = (EditCondition = "bUseActorPool"))
+	FSEActorClassFilter PooledActorFilter;
+
+	/** Max amount of actors of each class kept in the pool. The rest get destroyed */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serialization|Actors", AdvancedDisplay, meta = (EditCondition = "bUseActorPool", ClampMin = "1"))
+	int32 MaxPooledActorsPerClass = 256;
+
 	/** If true will store ActorComponents depending on the filters */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Serialization|Components")
 	bool bStoreComponents = true;
@@ -118,7 +179,9 @@ public:
 
 public:
 
-	/** Serialization will be multi-threaded between all available cores. */
+	/** Serialization will be multi-threaded between all available cores.
+	 * While loading, records are validated on worker threads as the file is decoded. They are applied on the game thread
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asynchronous")
 	ESaveASyncMode MultithreadedSerialization = ESaveASyncMode::SaveAsync;
 
@@ -137,10 +200,30 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asynchronous", meta = (UIMin="3", UIMax="10"))
 	float MaxFrameMs = 5.f;
 
+	/** If true, frame split loads restore the levels and actors closest to the players first.
+	 * The main level is always restored first.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asynchronous")
+	bool bPrioritizeByDistance = false;
+
 	/** Files will be loaded or saved on a secondary thread while game continues */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asynchronous")
 	ESaveASyncMode MultithreadedFiles = ESaveASyncMode::SaveAndLoadAsync;
 
+	/** If true, classes and assets referenced by a slot are loaded asynchronously before its data is deserialized.
+	 * Loading starts as soon as the file header is read, while the map opens.
+	 * Otherwise they are loaded synchronously when first found
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Asynchronous")
+	bool bPreloadReferences = true;
+
+	/** Max megabytes of records of hidden sub-levels kept in memory. 0 means no limit.
+	 * Records over it are moved to a scratch file, least recently used first, and read back when needed.
+	 * Performance: Keeps memory bounded in big streamed worlds, at the cost of disk access when levels are shown again
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Level Streaming", meta = (ClampMin = "0"))
+	int32 SubLevelRecordsBudgetMB = 0;
+
 
 protected:
 
@@ -158,10 +241,16 @@ public:
 	UFUNCTION(BlueprintNativeEvent, Category = "Slots", meta = (DisplayName="Get Slot Name from Id"))
 	void BPGetSlotNameFromId(int32 Id, FName& Name) const;
 
+	/** @param Index of the autosave slot, from 0 to AutoSaveSlots */
+	UFUNCTION(BlueprintNativeEvent, Category = "Slots", meta = (DisplayName="Get AutoSave Slot Name"))
+	void BPGetAutoSaveSlotName(int32 Index, FName& Name) const;
+
 protected:
 
 	virtual void GetSlotNameFromId(int32 Id, FName& Name) const;
 
+	virtual void GetAutoSaveSlotName(int32 Index, FName& Name) const;
+
 
 	/** HELPERS */
 public:
@@ -26,6 +26,16 @@ public:
     UPROPERTY(EditAnywhere, Category = "Save Extension", Config)
     bool bTickWithGameWorld = false;
 
+    /** Max megabytes of recently read slot files kept in memory. Reading them again skips the disk.
+     * Disabled if 0.
+     */
+    UPROPERTY(EditAnywhere, Category = "Save Extension", Config, meta = (ClampMin = "0", UIMax = "256"))
+    int32 FileCacheSizeMB = 32;
+
+    /** Max thumbnail textures kept in memory by USaveManager::RequestThumbnail */
+    UPROPERTY(EditAnywhere, Category = "Save Extension", Config, meta = (ClampMin = "0", UIMax = "128"))
+    int32 ThumbnailCacheSize = 32;
+
 
     USavePreset* CreatePreset(UObject* Outer) const;
 };
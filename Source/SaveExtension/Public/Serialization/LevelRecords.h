@@ -9,6 +9,9 @@
 
 #include "Records.h"
 #include "LevelFilter.h"
+
+class FSERecordSpillFile;
+struct FSERecordSpillRange;
 #include "LevelRecords.generated.h"
 
 
@@ -28,6 +31,9 @@ struct FLevelRecord : public FBaseRecord
 	/** Records of the World Actors */
 	TArray<FActorRecord> Actors;
 
+	/** Assets referenced by the records while saving. Not serialized with the records */
+	TSet<FSoftObjectPath> AssetReferences;
+
 
 	FLevelRecord() : Super() {}
 
@@ -35,7 +41,7 @@ struct FLevelRecord : public FBaseRecord
 
 	bool IsValid() const { return !Name.IsNone(); }
 
-	void CleanRecords();
+	virtual void CleanRecords();
 };
 
 
@@ -70,4 +76,51 @@ struct FStreamingLevelRecord : public FLevelRecord
 	{
 		return Level && Name == Level->GetWorldAssetPackageFName();
 	}
+
+	/** Serializes the records encoded apart from the name, so that loading doesn't decode them. See Decode() */
+	void SerializeLazy(FArchive& Ar);
+
+	/** Decodes the records if they were loaded lazily or spilled. Game thread only */
+	void Decode();
+
+	/** Keeps records in the format of FLevelRecord::Serialize encoded until needed. Only the name is read
+	 * @return false if the name can't be read
+	 */
+	bool SetEncoded(TArray<uint8>&& Bytes);
+
+	bool IsEncoded() const { return EncodedBytes.Num() > 0 || IsSpilled(); }
+	bool IsSpilled() const { return SpillRange.IsValid(); }
+
+	/** Copies the encoded records, reading them back if they were spilled */
+	bool ReadEncoded(TArray<uint8>& OutBytes) const;
+
+	/** Moves the records of this level to a scratch file, releasing their memory. See USavePreset::SubLevelRecordsBudgetMB */
+	bool Spill(const TSharedRef<FSERecordSpillFile, ESPMode::ThreadSafe>& File);
+
+	/** @return approximate bytes used in memory by the records. Measured again only after they change */
+	int64 GetRecordsSize() const;
+
+	/** Must be called when the records may be modified, so that their size is measured again */
+	void MarkRecordsChanged() { RecordsSize = INDEX_NONE; }
+
+	/** Encoded records are decoded before saving */
+	virtual bool Serialize(FArchive& Ar) override;
+	virtual void CleanRecords() override;
+
+	/** Time the records were last needed, for spilling the least used first */
+	uint64 LastUsedCycles = 0;
+
+private:
+
+	/** Records not decoded yet, in the format of FLevelRecord::Serialize */
+	TArray<uint8> EncodedBytes;
+
+	/** Where the encoded records are while spilled */
+	TSharedPtr<const FSERecordSpillRange, ESPMode::ThreadSafe> SpillRange;
+
+	/** Last measured size of the records. See GetRecordsSize */
+	mutable int64 RecordsSize = INDEX_NONE;
+
+	void Encode(TArray<uint8>& OutBytes);
+	void ResetEncoded();
 };
@@ -9,6 +9,7 @@
 #include <GameFramework/Controller.h>
 #include <Async/AsyncWork.h>
 
+#include "FileAdapter.h"
 #include "SavePreset.h"
 
 #include "MTTask.h"
@@ -39,6 +40,16 @@ class FMTTask_SerializeActors : public FMTTask
 
 	FActorRecord LevelScriptRecord;
 	TArray<FActorRecord> ActorRecords;
+	TSet<FSoftObjectPath> AssetReferences;
+
+	/** If set, actor records are encoded and written to this stream as they are serialized instead of kept */
+	FSaveFileStream* Stream = nullptr;
+	int32 LevelIndex = INDEX_NONE;
+	/** Write of the last chunk of this task. The next chunk waits for it, so only one is held at a time */
+	FGraphEventRef LastChunkWrite;
+
+	/** Actors encoded at once while streaming. Records of more actors are never kept */
+	static constexpr int32 ActorsPerChunk = 256;
 
 
 public:
@@ -58,6 +69,15 @@ public:
 		// ActorRecords.Reserve(Num);
 	}
 
+	/** Encodes actor records as chunks written to a FSaveFileStream. It must outlive the task
+	 * @param InLevelIndex of the level record in SubLevels, or INDEX_NONE for the main level
+	 */
+	void StreamRecords(FSaveFileStream& InStream, int32 InLevelIndex)
+	{
+		Stream = &InStream;
+		LevelIndex = InLevelIndex;
+	}
+
 	void DoWork();
 
 	/** Called after task has completed to recover resulting information */
@@ -67,6 +87,7 @@ public:
 
 		// Shrink not needed. Move wont keep reserved space
 		LevelRecord->Actors.Append(MoveTemp(ActorRecords));
+		LevelRecord->AssetReferences.Append(MoveTemp(AssetReferences));
 	}
 
 	FORCEINLINE TStatId GetStatId() const
@@ -78,9 +99,12 @@ private:
 
 	void SerializeGameInstance();
 
+	/** Encodes the actor records serialized so far into a chunk and appends it to the stream */
+	void EncodeChunk();
+
 	/** Serializes an actor into this Actor Record */
-	bool SerializeActor(const AActor* Actor, FActorRecord& Record) const;
+	bool SerializeActor(const AActor* Actor, FActorRecord& Record);
 
 	/** Serializes the components of an actor into a provided Actor Record */
-	inline void SerializeActorComponents(const AActor* Actor, FActorRecord& ActorRecord, int8 indent = 0) const;
+	inline void SerializeActorComponents(const AActor* Actor, FActorRecord& ActorRecord, int8 indent = 0);
 };
@@ -12,6 +12,60 @@
 class USlotData;
 
 
+namespace SERecords
+{
+	/**
+	 * Serializes an array in the same format as operator<<, but loading keeps the elements already in it.
+	 * Memory owned by those elements is then reused instead of allocated again
+	 */
+	template<typename T>
+	void SerializeArray(FArchive& Ar, TArray<T>& Array)
+	{
+		if (!Ar.IsLoading())
+		{
+			Ar << Array;
+			return;
+		}
+
+		int32 Num = 0;
+		Ar << Num;
+		if (Num < 0 || Ar.IsError())
+		{
+			Ar.SetError();
+			Array.Reset();
+			return;
+		}
+
+		Array.SetNum(Num, false);
+		for (T& Element : Array)
+		{
+			Ar << Element;
+		}
+	}
+
+	inline void SerializeArray(FArchive& Ar, TArray<uint8>& Bytes)
+	{
+		if (!Ar.IsLoading())
+		{
+			Ar << Bytes;
+			return;
+		}
+
+		int32 Num = 0;
+		Ar << Num;
+		if (Num < 0 || Ar.IsError())
+		{
+			Ar.SetError();
+			Bytes.Reset();
+			return;
+		}
+
+		Bytes.SetNumUninitialized(Num, false);
+		Ar.Serialize(Bytes.GetData(), Num);
+	}
+}
+
+
 USTRUCT()
 struct FBaseRecord
 {
@@ -3,15 +3,20 @@
 
 #include <CoreMinimal.h>
 #include <Serialization/ObjectAndNameAsStringProxyArchive.h>
+#include <UObject/SoftObjectPath.h>
 
 
 /** Serializes world data */
 struct FSEArchive : public FObjectAndNameAsStringProxyArchive
 {
+	/** If provided, assets referenced while saving are added here */
+	TSet<FSoftObjectPath>* ReferencedAssets = nullptr;
+
 public:
 
-	FSEArchive(FArchive &InInnerArchive, bool bInLoadIfFindFails)
+	FSEArchive(FArchive &InInnerArchive, bool bInLoadIfFindFails, TSet<FSoftObjectPath>* InReferencedAssets = nullptr)
 		: FObjectAndNameAsStringProxyArchive(InInnerArchive,bInLoadIfFindFails)
+		, ReferencedAssets(InReferencedAssets)
 	{
 		ArIsSaveGame = true;
 		ArNoDelta = true;
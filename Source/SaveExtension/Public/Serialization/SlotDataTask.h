@@ -16,6 +16,80 @@
 class USaveManager;
 
 
+/**
+ * Level records a task reads or writes while running.
+ * Tasks with conflicting access never run at the same time.
+ */
+struct FSlotDataTaskAccess
+{
+	/** Names of the level records. The main level is FPersistentLevelRecord::PersistentName */
+	TArray<FName, TInlineAllocator<2>> Reads;
+	TArray<FName, TInlineAllocator<2>> Writes;
+	bool bReadsAll = false;
+	bool bWritesAll = false;
+
+
+	static FSlotDataTaskAccess ReadAll()
+	{
+		FSlotDataTaskAccess Access;
+		Access.bReadsAll = true;
+		return Access;
+	}
+	static FSlotDataTaskAccess WriteAll()
+	{
+		FSlotDataTaskAccess Access;
+		Access.bWritesAll = true;
+		return Access;
+	}
+	static FSlotDataTaskAccess ReadLevel(FName Level)
+	{
+		FSlotDataTaskAccess Access;
+		Access.Reads.Add(Level);
+		return Access;
+	}
+	static FSlotDataTaskAccess WriteLevel(FName Level)
+	{
+		FSlotDataTaskAccess Access;
+		Access.Writes.Add(Level);
+		return Access;
+	}
+
+	bool IsEmpty() const
+	{
+		return !bReadsAll && !bWritesAll && Reads.Num() <= 0 && Writes.Num() <= 0;
+	}
+
+	bool Accesses(FName Level) const
+	{
+		return bReadsAll || bWritesAll || Reads.Contains(Level) || Writes.Contains(Level);
+	}
+
+	/** @return true if any of the two tasks writes a record the other accesses */
+	bool ConflictsWith(const FSlotDataTaskAccess& Other) const
+	{
+		return WritesAnyOf(Other) || Other.WritesAnyOf(*this);
+	}
+
+private:
+
+	bool WritesAnyOf(const FSlotDataTaskAccess& Other) const
+	{
+		if (bWritesAll)
+		{
+			return !Other.IsEmpty();
+		}
+		for (const FName Level : Writes)
+		{
+			if (Other.Accesses(Level))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+};
+
+
 /**
 * Base class for managing a SaveData file
 */
@@ -56,14 +130,29 @@ public:
 
 	virtual void Tick(float DeltaTime) {}
 
+	/** Completes a running task on this frame instead of waiting for the next ones. Used by emergency saves */
+	virtual void FinishNow() {}
+
 	void Finish(bool bSuccess);
 
+	/**
+	 * Removes a task that didn't start yet
+	 * @return true if the task was cancelled
+	 */
+	bool Cancel();
+
 	bool IsRunning() const { return bRunning; }
 	bool IsFinished() const { return bFinished; }
 	bool IsSucceeded() const { return IsFinished() && bSucceeded; }
 	bool IsFailed() const { return IsFinished() && !bSucceeded; }
 	bool IsScheduled() const;
 
+	/** @return the records this task reads or writes now. By default, all of them */
+	virtual FSlotDataTaskAccess GetAccess() const
+	{
+		return FSlotDataTaskAccess::WriteAll();
+	}
+
 	virtual void OnTick(float DeltaTime) {}
 
 protected:
@@ -72,13 +161,20 @@ protected:
 
 	virtual void OnFinish(bool bSuccess) {}
 
+	/** Called when cancelled before starting. Delegates should be notified of the failure */
+	virtual void OnCancel() {}
+
 	USaveManager* GetManager() const;
 
+	/** Must be called when the access of a running task is reduced, so that waiting tasks can start */
+	void OnAccessReduced();
+
 	void BakeAllFilters();
 
 	const FSELevelFilter& GetGeneralFilter() const;
 	const FSELevelFilter& GetLevelFilter(const FLevelRecord& Level) const;
 
+	/** Sub-level records are decoded here the first time they are needed */
 	FLevelRecord* FindLevelRecord(const ULevelStreaming* Level) const;
 
 	//~ Begin UObject Interface
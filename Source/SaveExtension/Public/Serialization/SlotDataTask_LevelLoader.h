@@ -30,9 +30,23 @@ public:
 		return this;
 	}
 
+	/** The record of the level is decoded when first needed, so it is written too */
+	virtual FSlotDataTaskAccess GetAccess() const override
+	{
+		return FSlotDataTaskAccess::WriteLevel(StreamingLevel ? StreamingLevel->GetWorldAssetPackageFName() : NAME_None);
+	}
+
+	virtual void FinishNow() override;
+
 private:
 
 	virtual void OnStart() override;
 
 	virtual void DeserializeASyncLoop(float StartMS = 0.0f) override;
+
+	/** Players are not restored with a level. Their view is used as it is now */
+	virtual void GetViewLocations(TArray<FVector>& OutLocations) override;
+
+	/** Records of the slot stay in use by other tasks. Only the record of this level was accessed */
+	virtual void ReleaseRecords() override {}
 };
@@ -30,6 +30,16 @@ public:
 		return this;
 	}
 
+	virtual bool CanCoalesce() const override
+	{
+		return false;
+	}
+
+	virtual FSlotDataTaskAccess GetAccess() const override
+	{
+		return FSlotDataTaskAccess::WriteLevel(StreamingLevel ? StreamingLevel->GetWorldAssetPackageFName() : NAME_None);
+	}
+
 private:
 
 	virtual void OnStart() override;
@@ -11,9 +11,11 @@
 #include "SlotDataTask.h"
 
 #include <Engine/Level.h>
+#include <Engine/StreamableManager.h>
 #include <Engine/LevelStreaming.h>
 #include <GameFramework/Actor.h>
 #include <Engine/LevelScriptActor.h>
+#include <Components/SceneComponent.h>
 #include <GameFramework/Controller.h>
 
 #include "SlotDataTask_Loader.generated.h"
@@ -23,14 +25,56 @@ enum class ELoadDataTaskState : uint8
 {
 	NotStarted,
 
-	// Once loading starts we either load the map
+	// Reading the header of the file to find its info and map
+	ReadingHeader,
+	// Once the info is known we either load the map
 	LoadingMap,
+	// Reading the file, loading the assets it references and deserializing its data
 	WaitingForData,
 
+	// Destroying and respawning actors. Only used on frame split loads
 	RestoringActors,
 	Deserializing
 };
 
+/** Steps to prepare a level. They can be resumed on the next frame on frame split loads */
+enum class EPrepareLevelStep : uint8
+{
+	None,
+	Indexing,
+	Destroying,
+	Respawning
+};
+
+/** Components of an actor to be deserialized */
+enum class EComponentsToLoad : uint8
+{
+	All,
+	// Components created on the actor's constructor. Exist before construction scripts run
+	Native,
+	// Components created by construction scripts
+	Constructed
+};
+
+/** Indices of actor records of a level, by actor name */
+using FActorRecordIndex = TMap<FName, int32>;
+
+/** An actor or level pending to be restored on frame split loads. Closer ones are restored first */
+template<typename T>
+struct TLoadPriority
+{
+	TWeakObjectPtr<T> Object;
+	float DistanceSquared = 0.f;
+	/** Attached actors go after their parents */
+	int32 Depth = 0;
+
+	bool operator<(const TLoadPriority& Other) const
+	{
+		return DistanceSquared < Other.DistanceSquared
+			|| (DistanceSquared == Other.DistanceSquared && Depth < Other.Depth);
+	}
+};
+
 /**
 * Manages the loading process of a SaveData file
 */
@@ -41,6 +85,9 @@ class USlotDataTask_Loader : public USlotDataTask
 
 	FName SlotName;
 
+	/** If set, the slot is restored from this snapshot instead of disk */
+	TSharedPtr<const FSaveFile> Snapshot;
+
 	UPROPERTY()
 	USlotInfo* NewSlotInfo;
 
@@ -55,10 +102,34 @@ protected:
 	int32 CurrentActorIndex = 0;
 	TArray<TWeakObjectPtr<AActor>> CurrentLevelActors;
 
+	// Heaps of pending actors and levels if prioritized by distance
+	TArray<TLoadPriority<AActor>> ActorQueue;
+	TArray<TLoadPriority<ULevelStreaming>> LevelQueue;
+
+	// Level preparation variables
+	EPrepareLevelStep PrepareStep = EPrepareLevelStep::None;
+	int32 CurrentRecordIndex = 0;
+	TBitArray<> FoundRecords;
+	TArray<FActorRecord*> ActorsToSpawn;
+
+	/** Actor record indices of each level record, by level name */
+	TMap<FName, FActorRecordIndex> ActorRecordIndices;
+
+	/** Actors respawned with their records already applied. Only used for comparison */
+	TSet<const AActor*> RespawnedActors;
+
+	/** Transform propagation and overlaps of moved components, deferred until a level or frame ends */
+	TArray<TUniquePtr<FScopedMovementUpdate>> MovementScopes;
+
 	/** Start AsyncTasks */
 	FAsyncTask<FLoadFileTask>* LoadDataTask;
 	/** End AsyncTasks */
 
+	/** True once LoadDataTask creates the data objects, after references were loaded */
+	bool bDeserializingData = false;
+	bool bPreloadRequested = false;
+	TSharedPtr<FStreamableHandle> PreloadHandle;
+
 	ELoadDataTaskState LoadState = ELoadDataTaskState::NotStarted;
 
 
@@ -72,6 +143,12 @@ public:
 		return this;
 	}
 
+	auto SetupSnapshot(TSharedPtr<const FSaveFile> InSnapshot)
+	{
+		Snapshot = MoveTemp(InSnapshot);
+		return this;
+	}
+
 	auto Bind(const FOnGameLoaded& OnLoaded) { Delegate = OnLoaded; return this; }
 
 	void OnMapLoaded();
@@ -87,15 +164,27 @@ private:
 	void StartDeserialization();
 
 	/** Spawns Actors hat were saved but which actors are not in the world. */
-	void RespawnActors(const TArray<FActorRecord*>& Records, const ULevel* Level);
+	void RespawnActors(TArrayView<FActorRecord* const> Records, const ULevel* Level, const FSELevelFilter& Filter);
+
+	/** @return true if an actor without record can be pooled instead of destroyed */
+	bool CanPoolActor(const AActor* Actor) const;
 
 protected:
 
 	//~ Begin Files
 	void StartLoadingData();
 
+	/** Creates the info once the header of the file is read. Fails if the file doesn't exist */
+	void UpdateReadingHeader();
+
+	/** Loads the map of the slot if needed, then waits for its data */
+	void OnInfoRead();
+
+	/** Preloads the references of the file once known and deserializes its data when they are loaded */
+	void UpdateLoadingData();
+
 	USlotData* GetLoadedData() const;
-	FORCEINLINE const bool IsDataLoaded() const { return LoadDataTask && LoadDataTask->IsDone(); };
+	FORCEINLINE const bool IsDataLoaded() const { return LoadDataTask && bDeserializingData && LoadDataTask->IsDone(); };
 	//~ End Files
 
 
@@ -104,20 +193,59 @@ protected:
 	void DeserializeSync();
 	void DeserializeLevelSync(const ULevel* Level, const ULevelStreaming* StreamingLevel = nullptr);
 
-	void DeserializeASync();
-	void DeserializeLevelASync(ULevel* Level, ULevelStreaming* StreamingLevel = nullptr);
+	void DeserializeASync(float StartMS = 0.0f);
+	void DeserializeLevelASync(ULevel* Level, ULevelStreaming* StreamingLevel = nullptr, float StartMS = 0.0f);
 
 	virtual void DeserializeASyncLoop(float StartMS = 0.0f);
 
 	void FinishedDeserializing();
 
+	/** Cleans records already applied, unless the next load reuses them */
+	virtual void ReleaseRecords();
+
 	void PrepareAllLevels();
-	void PrepareLevel(const ULevel* Level, FLevelRecord& LevelRecord);
+
+	/** Prepares all loaded levels one after another, within MaxFrameMs every frame */
+	void PrepareASyncLoop(float StartMS = 0.0f);
+
+	/**
+	 * Destroys actors without records and respawns records without actors.
+	 * @param bFrameSplit if true, preparation stops after MaxFrameMs and can be continued calling this again
+	 * @return true once the level is fully prepared
+	 */
+	bool PrepareLevel(const ULevel* Level, FLevelRecord& LevelRecord, bool bFrameSplit = false, float StartMS = 0.0f);
+
+	/** @return the actor record index of a level. Builds it if needed */
+	FActorRecordIndex& GetActorRecordIndex(const FLevelRecord& LevelRecord);
+
+	/** @return the index of the record matching an actor, or INDEX_NONE */
+	int32 FindActorRecordIndex(const FLevelRecord& LevelRecord, const AActor* Actor);
 
 	/** Deserializes all Level actors. */
 	inline void DeserializeLevel_Actor(AActor* const Actor, const FLevelRecord& LevelRecord, const FSELevelFilter& Filter);
 
-	void FindNextAsyncLevel(ULevelStreaming*& OutLevelStreaming) const;
+	void FindNextAsyncLevel(ULevelStreaming*& OutLevelStreaming);
+
+	/** Finds the view points of all players once restored, from the saved transforms of their pawns */
+	virtual void GetViewLocations(TArray<FVector>& OutLocations);
+
+	/** Adds the view point a player has now */
+	static void GetCurrentViewLocation(const APlayerController* Controller, TArray<FVector>& OutLocations);
+
+	/** Orders loaded streaming levels by distance to the players, if enabled */
+	void QueueAsyncLevels();
+
+	/**
+	 * Gets the next actor of the current level to deserialize, closest first if prioritized by distance
+	 * @return false once all actors were iterated
+	 */
+	bool PopNextAsyncActor(AActor*& OutActor);
+
+	/** Defers transform propagation and overlaps of a component until FlushMovementUpdates */
+	void DeferMovementUpdates(USceneComponent* Component);
+
+	/** Applies all deferred movement updates at once */
+	void FlushMovementUpdates();
 
 private:
 
@@ -128,7 +256,14 @@ private:
 	/** Serializes an actor into this Actor Record */
 	bool DeserializeActor(AActor* Actor, const FActorRecord& Record, const FSELevelFilter& Filter);
 
+	/** Applies the saved velocities of an actor */
+	void DeserializeActorPhysics(AActor* Actor, const FActorRecord& Record);
+
+	/** Deserializes the properties of an actor from a provided Record */
+	void DeserializeActorData(AActor* Actor, const FActorRecord& Record);
+
 	/** Deserializes the components of an actor from a provided Record */
-	void DeserializeActorComponents(AActor* Actor, const FActorRecord& ActorRecord, const FSELevelFilter& Filter, int8 indent = 0);
+	void DeserializeActorComponents(AActor* Actor, const FActorRecord& ActorRecord, const FSELevelFilter& Filter,
+		int8 indent = 0, EComponentsToLoad Selection = EComponentsToLoad::All);
 	/** END Deserialization */
 };
\ No newline at end of file
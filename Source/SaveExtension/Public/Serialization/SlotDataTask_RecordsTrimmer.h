@@ -0,0 +1,23 @@
+// Copyright 2015-2020 Piperift. All Rights Reserved.
+
+#pragma once
+
+#include "ISaveExtension.h"
+
+#include "SlotDataTask.h"
+#include "SlotDataTask_RecordsTrimmer.generated.h"
+
+
+/**
+* Moves records of hidden sub-levels to disk while they exceed USavePreset::SubLevelRecordsBudgetMB.
+* Any level can be spilled, so it waits for all tasks using records
+*/
+UCLASS()
+class USlotDataTask_RecordsTrimmer : public USlotDataTask
+{
+	GENERATED_BODY()
+
+private:
+
+	virtual void OnStart() override;
+};
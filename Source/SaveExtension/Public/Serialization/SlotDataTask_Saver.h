@@ -4,6 +4,7 @@
 
 #include "Delegates.h"
 #include "ISaveExtension.h"
+#include "Misc/ThumbnailCapture.h"
 #include "MTTask_SerializeActors.h"
 #include "Multithreading/SaveFileTask.h"
 #include "SavePreset.h"
@@ -35,7 +36,23 @@ class USlotDataTask_Saver : public USlotDataTask
 	int32 Width;
 	int32 Height;
 
-	FOnGameSaved Delegate;
+	/** If true the slot is kept in memory as a snapshot */
+	bool bSnapshot = false;
+	/** If true a snapshot is also saved to disk */
+	bool bFlushSnapshot = false;
+
+	/** Delegates of all the save requests merged into this task */
+	TArray<FOnGameSaved> Delegates;
+
+	/** Thumbnail being captured to embed in the file. The file is written once it is done */
+	TSharedPtr<FSEThumbnailCapture, ESPMode::ThreadSafe> ThumbnailCapture;
+	bool bWaitingForThumbnail = false;
+
+	/** Writes records while they are serialized. See USavePreset::bStreamRecords */
+	TUniquePtr<FSaveFileStream> Stream;
+
+	/** Summary of the file being written. Added to the slot index once written */
+	FSlotSummary SavedSummary;
 
 protected:
 
@@ -73,14 +90,58 @@ public:
 		return this;
 	}
 
-	auto* Bind(const FOnGameSaved& OnSaved) { Delegate = OnSaved; return this; }
+	/** Saves into a snapshot instead of a file. See USaveManager::CaptureSnapshot */
+	auto* SetupSnapshot(FName InSlotName, bool bInFlushToDisk)
+	{
+		Setup(InSlotName, true, false, 0, 0);
+		bSnapshot = true;
+		bFlushSnapshot = bInFlushToDisk;
+		return this;
+	}
+
+	auto* Bind(const FOnGameSaved& OnSaved)
+	{
+		if (OnSaved.IsBound())
+		{
+			Delegates.Add(OnSaved);
+		}
+		return this;
+	}
+
+	/** Merges a newer save request to the same slot into this task while it waits to start */
+	auto* Coalesce(bool bInOverride, bool bInSaveThumbnail, const int32 InWidth, const int32 InHeight)
+	{
+		bOverride = bInOverride;
+		if (bInSaveThumbnail)
+		{
+			bSaveThumbnail = true;
+			Width = InWidth;
+			Height = InHeight;
+		}
+		return this;
+	}
+
+	/** @return true if other save requests to the same slot can be merged into this task */
+	virtual bool CanCoalesce() const
+	{
+		return !bSnapshot;
+	}
+
+	FName GetSlotName() const
+	{
+		return SlotName;
+	}
 
 	// Where all magic happens
 	virtual void OnStart() override;
 	virtual void Tick(float DeltaTime) override;
+	virtual void FinishNow() override;
 	virtual void OnFinish(bool bSuccess) override;
+	virtual void OnCancel() override;
 	virtual void BeginDestroy() override;
 
+	virtual FSlotDataTaskAccess GetAccess() const override;
+
 protected:
 
 	/** BEGIN Serialization */
@@ -17,6 +17,27 @@
 #include "SlotData.generated.h"
 
 
+/**
+ * Records of a SlotData, kept apart from it.
+ * Plain data that can be decoded on any thread without creating objects
+ */
+struct SAVEEXTENSION_API FSlotDataRecords
+{
+	bool bStoreGameInstance = false;
+	FObjectRecord GameInstance;
+
+	FSELevelFilter GeneralLevelFilter;
+	FPersistentLevelRecord MainLevel;
+	TArray<FStreamingLevelRecord> SubLevels;
+
+
+	/** @param bLazySubLevels if true sub-levels are kept encoded until needed. See FStreamingLevelRecord::Decode */
+	void Serialize(FArchive& Ar, bool bLazySubLevels = true);
+	/** Serializes the records that don't belong to a level */
+	void SerializeGlobals(FArchive& Ar);
+};
+
+
 /**
  * USaveData stores all information that can be accessible only while the game is loaded.
  * Works like a common SaveGame object
@@ -56,4 +77,21 @@ public:
 
 	/** Using manual serialization. It's way faster than reflection serialization */
 	virtual void Serialize(FArchive& Ar) override;
+
+	/** Serializes everything but the records. See SerializeRecords */
+	void SerializeProperties(FArchive& Ar);
+
+	/** Serializes only the records, in the same format as FSlotDataRecords */
+	void SerializeRecords(FArchive& Ar, bool bLazySubLevels = true);
+
+	/** Serializes the records that don't belong to a level, in the same format as FSlotDataRecords */
+	void SerializeGlobals(FArchive& Ar);
+
+	/** Swaps records with ones decoded apart. Previous records are left in them */
+	void SwapRecords(FSlotDataRecords& Records);
+
+private:
+
+	/** True while only properties are serialized */
+	bool bSkipRecords = false;
 };
@@ -8,6 +8,45 @@
 
 #include "SlotInfo.generated.h"
 
+class USlotInfo;
+
+
+/**
+ * Copy of the common fields of a SlotInfo, stored on the header of each file.
+ * Slots can be listed with summaries without creating any UObject
+ */
+USTRUCT(BlueprintType)
+struct SAVEEXTENSION_API FSlotSummary
+{
+	GENERATED_BODY()
+
+	/** Slot where this summary was read from */
+	UPROPERTY(BlueprintReadOnly, Category = SlotSummary)
+	FName FileName;
+
+	UPROPERTY(BlueprintReadOnly, Category = SlotSummary)
+	FText DisplayName;
+
+	UPROPERTY(BlueprintReadOnly, Category = SlotSummary)
+	FTimespan PlayedTime;
+
+	UPROPERTY(BlueprintReadOnly, Category = SlotSummary)
+	FTimespan SlotPlayedTime;
+
+	UPROPERTY(BlueprintReadOnly, Category = SlotSummary)
+	FDateTime SaveDate { 0 };
+
+	UPROPERTY(BlueprintReadOnly, Category = SlotSummary)
+	FName Map;
+
+
+	FSlotSummary() = default;
+	explicit FSlotSummary(const USlotInfo& Info);
+
+	/** FileName is not serialized, it comes from the file */
+	friend FArchive& operator<<(FArchive& Ar, FSlotSummary& Summary);
+};
+
 
 /**
  * USaveInfo stores information that needs to be accessible WITHOUT loading the game.
@@ -60,6 +99,9 @@ private:
 	UPROPERTY()
 	FString ThumbnailPath;
 
+	/** Compressed thumbnail stored inside the save file. See USavePreset::bEmbedThumbnails */
+	TArray<uint8> EmbeddedThumbnail;
+
 	/** Thumbnail gets cached here the first time it is requested */
 	UPROPERTY(Transient)
 	UTexture2D* CachedThumbnail;
@@ -80,4 +122,9 @@ public:
 
 	/** Internal Usage. Will be called to remove previous thumbnail */
 	FString _GetThumbnailPath() { return ThumbnailPath; }
+
+	/** Internal Usage. Will be called when an embedded thumbnail is captured or read */
+	void _SetEmbeddedThumbnail(TArray<uint8> Image);
+
+	const TArray<uint8>& GetEmbeddedThumbnail() const { return EmbeddedThumbnail; }
 };
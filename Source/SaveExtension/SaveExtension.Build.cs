@@ -21,7 +21,9 @@ public class SaveExtension : ModuleRules
 			"CoreUObject",
 			"DeveloperSettings",
 			"ImageWrapper",
-			"NavigationSystem"
+			"NavigationSystem",
+			"RenderCore",
+			"RHI"
 		});
 	}
 }
@@ -4,6 +4,15 @@
 #include "Helpers/TestActor.h"
 #include "SaveManager.h"
 #include "FileAdapter.h"
+#include "SaveSettings.h"
+#include "Misc/RecordSpillFile.h"
+
+#include <HAL/FileManager.h>
+#include <IImageWrapper.h>
+#include <IImageWrapperModule.h>
+#include <Misc/FileHelper.h>
+#include <Serialization/MemoryReader.h>
+#include <Serialization/MemoryWriter.h>
 
 
 class FSaveSpec_Files : public Automatron::FTestSpec
@@ -18,6 +27,9 @@ class FSaveSpec_Files : public Automatron::FTestSpec
 	// Helper for some test delegates
 	bool bFinishTick = false;
 
+	/** Setting restored after each test */
+	int32 ThumbnailCacheSize = 0;
+
 	FSaveSpec_Files() : Automatron::FTestSpec()
 	{
 		bReuseWorldForAllTests = false;
@@ -29,6 +41,8 @@ class FSaveSpec_Files : public Automatron::FTestSpec
 void FSaveSpec_Files::Define()
 {
 	BeforeEach([this]() {
+		ThumbnailCacheSize = GetDefault<USaveSettings>()->ThumbnailCacheSize;
+
 		SaveManager = USaveManager::Get(GetMainWorld());
 		TestNotNull(TEXT("SaveManager"), SaveManager);
 
@@ -78,7 +92,390 @@ void FSaveSpec_Files::Define()
 		TestNotNull("Data is valid", Data);
 	});
 
+	It("Reads recently read files from the cache", [this]() {
+		TestPreset->MultithreadedFiles = ESaveASyncMode::OnlySync;
+		FFileAdapter::SetFileCacheBudget(1024 * 1024);
+
+		TestTrue("Saved", SaveManager->SaveSlot(0));
+
+		TSharedPtr<const FSaveFile> File = FFileAdapter::ReadFile(TEXT("0"), false);
+		TestTrue("File was read", File.IsValid());
+		TestTrue("File was cached", FFileAdapter::ReadFile(TEXT("0"), false) == File);
+
+		TestTrue("Saved again", SaveManager->SaveSlot(0));
+		TestFalse("Saving invalidates the cache", FFileAdapter::FindCachedFile(TEXT("0"), true).IsValid());
+
+		// A file read before the last save could be outdated
+		const uint64 Generation = FFileAdapter::GetFileCacheGeneration();
+		TestTrue("Saved again", SaveManager->SaveSlot(0));
+		FFileAdapter::CacheFile(TEXT("0"), File.ToSharedRef(), true, Generation);
+		TestFalse("Files read before saving are not cached", FFileAdapter::FindCachedFile(TEXT("0"), true).IsValid());
+	});
+
+	It("Decodes records apart from the data", [this]() {
+		TestPreset->MultithreadedFiles = ESaveASyncMode::OnlySync;
+		TestPreset->ActorFilter.ClassFilter.AllowedClasses.Add(ATestActor::StaticClass());
+		ATestActor* Actor = GetMainWorld()->SpawnActor<ATestActor>();
+		const FName ActorName = Actor->GetFName();
+		const auto HasActor = [ActorName](const FLevelRecord& Level) {
+			return Level.Actors.ContainsByPredicate([ActorName](const FActorRecord& Record) {
+				return Record.Name == ActorName;
+			});
+		};
+
+		TestTrue("Saved", SaveManager->SaveSlot(0));
+		Actor->Destroy();
+
+		TSharedPtr<const FSaveFile> File = FFileAdapter::ReadFile(TEXT("0"), false);
+		TestTrue("File was read", File.IsValid());
+		if (!File)
+		{
+			return;
+		}
+		TestTrue("Records are saved apart", File->HasRecordBytes());
+
+		FSlotDataRecords Records;
+		TestTrue("Records were decoded", File->DeserializeRecords(Records));
+		TestTrue("Actor record was decoded", HasActor(Records.MainLevel));
+
+		const USlotData* Data = File->CreateAndDeserializeData(SaveManager, &Records);
+		TestTrue("Records were moved into the data", Data && HasActor(Data->MainLevel));
+		if (!Data)
+		{
+			return;
+		}
+
+		// Files before version 6 keep records inside the data bytes
+		FSaveFile OldFile{ *File };
+		OldFile.SaveGameFileVersion = 5;
+		OldFile.RecordBytes.Empty();
+		OldFile.DataBytes.Reset();
+		{
+			FMemoryWriter Writer{ OldFile.DataBytes };
+			FObjectAndNameAsStringProxyArchive Ar(Writer, false);
+			const_cast<USlotData*>(Data)->Serialize(Ar);
+		}
+		TestFalse("Old file has no record bytes", OldFile.DeserializeRecords(Records));
+
+		const USlotData* OldData = OldFile.CreateAndDeserializeData(SaveManager);
+		TestTrue("Records were read from an old file", OldData && HasActor(OldData->MainLevel));
+	});
+
+	It("Keeps sub-level records encoded until needed", [this]() {
+		TestPreset->MultithreadedFiles = ESaveASyncMode::OnlySync;
+		TestPreset->ActorFilter.ClassFilter.AllowedClasses.Add(ATestActor::StaticClass());
+		GetMainWorld()->SpawnActor<ATestActor>();
+		TestTrue("Saved", SaveManager->SaveSlot(0));
+
+		USlotData* Data = SaveManager->GetCurrentData();
+		TestTrue("Test world has no sub-levels", Data && Data->SubLevels.Num() == 0);
+		if (!Data || Data->SubLevels.Num() > 0)
+		{
+			return;
+		}
+		const int32 NumActors = Data->MainLevel.Actors.Num();
+
+		const auto Write = [](USlotData* From, bool bLazySubLevels) {
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer{ Bytes };
+			FObjectAndNameAsStringProxyArchive Ar(Writer, false);
+			From->SerializeRecords(Ar, bLazySubLevels);
+			return Bytes;
+		};
+		const auto Read = [this](const TArray<uint8>& Bytes, bool bLazySubLevels) {
+			USlotData* To = NewObject<USlotData>(SaveManager);
+			FMemoryReader Reader{ Bytes };
+			FObjectAndNameAsStringProxyArchive Ar(Reader, true);
+			To->SerializeRecords(Ar, bLazySubLevels);
+			return To;
+		};
+
+		// Sub-levels use the format of the main level. It is written again as the only sub-level
+		TArray<uint8> Globals;
+		{
+			FMemoryWriter Writer{ Globals };
+			FObjectAndNameAsStringProxyArchive Ar(Writer, false);
+			Data->SerializeGlobals(Ar);
+		}
+		TArray<uint8> Bytes = Write(Data, false);
+		const int32 NumOffset = Bytes.Num() - sizeof(int32);
+		const TArray<uint8> MainBytes{ Bytes.GetData() + Globals.Num(), NumOffset - Globals.Num() };
+		Bytes.SetNum(NumOffset);
+		int32 NumSubLevels = 1;
+		Bytes.Append(reinterpret_cast<const uint8*>(&NumSubLevels), sizeof(int32));
+		Bytes.Append(MainBytes);
+		USlotData* WithSubLevel = Read(Bytes, false);
+		TestTrue("Sub-level was read", WithSubLevel->SubLevels.Num() == 1 && WithSubLevel->SubLevels[0].Actors.Num() == NumActors);
+
+		const TArray<uint8> LazyBytes = Write(WithSubLevel, true);
+		USlotData* Lazy = Read(LazyBytes, true);
+		TestTrue("Sub-level is kept encoded", Lazy->SubLevels.Num() == 1 && Lazy->SubLevels[0].IsEncoded() && Lazy->SubLevels[0].Actors.Num() == 0);
+		if (Lazy->SubLevels.Num() != 1)
+		{
+			return;
+		}
+		TestEqual("Name is read before decoding", Lazy->SubLevels[0].Name, FPersistentLevelRecord::PersistentName);
+
+		TestTrue("Saved again as it was read", Write(Lazy, true) == LazyBytes);
+		TestTrue("Still encoded", Lazy->SubLevels[0].IsEncoded());
+
+		// Streamed saves copy encoded levels without decoding them
+		{
+			FSaveFileStream Stream{ TEXT("Streamed"), false };
+			TestTrue("Streamed", Stream.Finish(SaveManager->GetCurrentInfo(), Lazy));
+		}
+		TestTrue("Still encoded after streaming", Lazy->SubLevels[0].IsEncoded());
+		TSharedPtr<const FSaveFile> File = FFileAdapter::ReadFile(TEXT("Streamed"), false);
+		USlotData* Streamed = File ? File->CreateAndDeserializeData(SaveManager) : nullptr;
+		TestTrue("Streamed file was read", Streamed && Streamed->SubLevels.Num() == 1);
+		if (Streamed && Streamed->SubLevels.Num() == 1)
+		{
+			TestTrue("Streamed sub-level is kept encoded", Streamed->SubLevels[0].IsEncoded());
+			TestEqual("Streamed sub-level name is read", Streamed->SubLevels[0].Name, FPersistentLevelRecord::PersistentName);
+			Write(Streamed, false);
+			TestEqual("Streamed sub-level decodes", Streamed->SubLevels[0].Actors.Num(), NumActors);
+		}
+
+		// Written in full, levels are decoded
+		Write(Lazy, false);
+		TestFalse("Decoded", Lazy->SubLevels[0].IsEncoded());
+		TestEqual("Actors were decoded", Lazy->SubLevels[0].Actors.Num(), NumActors);
+
+		TArray<uint8> Corrupt = LazyBytes;
+		const int32 NegativeNum = -1;
+		FMemory::Memcpy(Corrupt.GetData() + NumOffset, &NegativeNum, sizeof(int32));
+		TestEqual("Invalid count is rejected", Read(Corrupt, true)->SubLevels.Num(), 0);
+	});
+
+	It("Rejects record chunks of levels that were not saved", [this]() {
+		FSaveFile File{};
+		File.bRecordsChunked = true;
+		{
+			FMemoryWriter Writer{ File.RecordBytes };
+			uint8 Type = uint8(ESERecordChunk::Actors);
+			int32 LevelIndex = MAX_int32;
+			TArray<uint8> Payload;
+			Writer << Type << LevelIndex << Payload;
+		}
+
+		FSlotDataRecords Records;
+		TestFalse("Decoding failed", File.DeserializeRecords(Records));
+		TestEqual("No sub-levels were created", Records.SubLevels.Num(), 0);
+	});
+
+	It("Can read slot summaries without their info", [this]() {
+		TestPreset->MultithreadedFiles = ESaveASyncMode::OnlySync;
+
+		TestTrue("Saved", SaveManager->SaveSlot(0));
+
+		FSlotSummary Summary;
+		TestTrue("Summary was read", SaveManager->GetSlotSummary(TEXT("0"), Summary));
+		TestEqual("Summary file name", Summary.FileName, FName{ TEXT("0") });
+		TestEqual("Summary save date", Summary.SaveDate, SaveManager->GetCurrentInfo()->SaveDate);
+		TestEqual("Summary map", Summary.Map, SaveManager->GetCurrentInfo()->Map);
+	});
+
+	It("Can query pages of slots", [this]() {
+		TestPreset->MultithreadedFiles = ESaveASyncMode::OnlySync;
+
+		TestTrue("Saved", SaveManager->SaveSlot(0));
+		TestTrue("Saved", SaveManager->SaveSlot(1));
+		TestTrue("Saved", SaveManager->SaveSlot(2));
+
+		FSlotQuery Query;
+		Query.Offset = 1;
+		Query.Count = 5;
+		Query.SortBy = ESlotSortKey::FileName;
+		Query.bDescending = false;
+
+		bFinishTick = false;
+		SaveManager->QuerySlots(Query, FOnSlotsQueried::CreateLambda([this](const TArray<FSlotSummary>& Page, int32 NumMatches) {
+			TestEqual("Matches", NumMatches, 3);
+			TestEqual("Page size", Page.Num(), 2);
+			TestEqual("First slot of the page", Page.Num() > 0 ? Page[0].FileName : NAME_None, FName{ TEXT("1") });
+			bFinishTick = true;
+		}));
+		TickWorldUntil(GetMainWorld(), true, [this](float) {
+			return !bFinishTick;
+		});
+
+		// Saving updates the index
+		TestTrue("Saved", SaveManager->SaveSlot(3));
+		bool bQueried = false;
+		SaveManager->QuerySlots(Query, FOnSlotsQueried::CreateLambda([this, &bQueried](const TArray<FSlotSummary>& Page, int32 NumMatches) {
+			TestEqual("Matches", NumMatches, 4);
+			bQueried = true;
+		}));
+		TestTrue("Queried immediately from the index", bQueried);
+	});
+
+	It("Requests a missing thumbnail asynchronously", [this]() {
+		TestPreset->MultithreadedFiles = ESaveASyncMode::OnlySync;
+		TestTrue("Saved", SaveManager->SaveSlot(0));
+
+		int32 NumLoaded = 0;
+		const FOnThumbnailLoaded OnLoaded = FOnThumbnailLoaded::CreateLambda([this, &NumLoaded](UTexture2D* Thumbnail) {
+			TestNull("Thumbnail", Thumbnail);
+			++NumLoaded;
+		});
+		SaveManager->RequestThumbnail(TEXT("0"), OnLoaded);
+		SaveManager->RequestThumbnail(TEXT("0"), OnLoaded);
+		TickWorldUntil(GetMainWorld(), true, [&NumLoaded](float) {
+			return NumLoaded < 2;
+		});
+		TestEqual("Both requests notified", NumLoaded, 2);
+	});
+
+	It("Decodes thumbnails once and caches them", [this]() {
+		TestPreset->MultithreadedFiles = ESaveASyncMode::OnlySync;
+		TestTrue("Saved", SaveManager->SaveSlot(0));
+		TestTrue("Saved", SaveManager->SaveSlot(1));
+		SaveManager->ClearThumbnailCache();
+		GetMutableDefault<USaveSettings>()->ThumbnailCacheSize = 1;
+
+		// Modification times are set ahead, since writes within the same second may keep them
+		IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+		const auto WriteThumbnail = [&ImageWrapperModule](const FString& SlotName, int32 Width, FTimespan Ahead) {
+			TArray<FColor> Pixels;
+			Pixels.Init(FColor::Red, Width * 4);
+			TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+			if (!ImageWrapper || !ImageWrapper->SetRaw(Pixels.GetData(), Pixels.Num() * sizeof(FColor), Width, 4, ERGBFormat::BGRA, 8))
+			{
+				return false;
+			}
+			const TArray64<uint8> Compressed = ImageWrapper->GetCompressed();
+			const TArray<uint8> Image{ Compressed.GetData(), int32(Compressed.Num()) };
+			const FString Path = FFileAdapter::GetThumbnailPath(SlotName);
+			return FFileHelper::SaveArrayToFile(Image, *Path) && IFileManager::Get().SetTimeStamp(*Path, FDateTime::UtcNow() + Ahead);
+		};
+		const auto Request = [this](FName SlotName) {
+			UTexture2D* Thumbnail = nullptr;
+			bool bLoaded = false;
+			SaveManager->RequestThumbnail(SlotName, FOnThumbnailLoaded::CreateLambda([&Thumbnail, &bLoaded](UTexture2D* Loaded) {
+				Thumbnail = Loaded;
+				bLoaded = true;
+			}));
+			TickWorldUntil(GetMainWorld(), true, [&bLoaded](float) {
+				return !bLoaded;
+			});
+			return Thumbnail;
+		};
+
+		TestTrue("Thumbnail written", WriteThumbnail(TEXT("0"), 8, FTimespan::FromDays(1)));
+		UTexture2D* First = Request(TEXT("0"));
+		TestTrue("Thumbnail decoded", First && First->GetSizeX() == 8);
+		TestTrue("Same texture from the cache", Request(TEXT("0")) == First);
+		TestTrue("Cached", SaveManager->FindCachedThumbnail(TEXT("0")) == First);
+
+		TestTrue("Second thumbnail written", WriteThumbnail(TEXT("1"), 8, FTimespan::FromDays(1)));
+		TestNotNull("Second thumbnail decoded", Request(TEXT("1")));
+		TestNull("Oldest thumbnail evicted", SaveManager->FindCachedThumbnail(TEXT("0")));
+
+		TestTrue("Thumbnail changed", WriteThumbnail(TEXT("1"), 16, FTimespan::FromDays(2)));
+		UTexture2D* Changed = Request(TEXT("1"));
+		TestTrue("Changed thumbnail decoded again", Changed && Changed->GetSizeX() == 16);
+	});
+
+	It("Stores embedded thumbnails in the header", [this]() {
+		TestPreset->MultithreadedFiles = ESaveASyncMode::OnlySync;
+		TestTrue("Saved", SaveManager->SaveSlot(0));
+
+		// Bigger than the bytes first read for a header
+		TArray<uint8> Thumbnail;
+		Thumbnail.Init(5, 100 * 1024);
+		USlotInfo* Info = SaveManager->GetCurrentInfo();
+		Info->_SetEmbeddedThumbnail(Thumbnail);
+
+		FSaveFile File{};
+		File.SerializeInfo(Info);
+		File.SerializeData(SaveManager->GetCurrentData());
+		TestTrue("Saved with thumbnail", FFileAdapter::SaveFile(TEXT("0"), File, false));
+
+		TSharedPtr<const FSaveFile> Header = FFileAdapter::ReadFile(TEXT("0"), true);
+		TestTrue("Header was read", Header.IsValid());
+		TestTrue("Thumbnail bytes", Header.IsValid() && Header->ThumbnailBytes == Thumbnail);
+		TestTrue("Info was read after the thumbnail", Header.IsValid() && Header->InfoBytes == File.InfoBytes);
+	});
+
+	It("Doesn't keep the embedded thumbnail of a previous save", [this]() {
+		TestPreset->MultithreadedFiles = ESaveASyncMode::OnlySync;
+		TestTrue("Saved", SaveManager->SaveSlot(0));
+
+		SaveManager->GetCurrentInfo()->_SetEmbeddedThumbnail({ 1, 2, 3 });
+		TestTrue("Saved without thumbnail", SaveManager->SaveSlot(0));
+		TestEqual("Info thumbnail cleared", SaveManager->GetCurrentInfo()->GetEmbeddedThumbnail().Num(), 0);
+
+		TSharedPtr<const FSaveFile> File = FFileAdapter::ReadFile(TEXT("0"), true);
+		TestTrue("Header was read", File.IsValid());
+		TestEqual("No thumbnail bytes", File.IsValid() ? File->ThumbnailBytes.Num() : -1, 0);
+	});
+
+	It("Spills records to disk and reads them back", [this]() {
+		const FString Leftover = FSERecordSpillFile::GetDirectory() / TEXT("Records-Leftover.tmp");
+		TestTrue("Leftover created", FFileHelper::SaveStringToFile(TEXT("Old"), *Leftover));
+		FSERecordSpillFile::DeleteLeftovers();
+		TestFalse("Leftover deleted", IFileManager::Get().FileExists(*Leftover));
+
+		TArray<uint8> First{ 1, 2, 3 };
+		TArray<uint8> Second;
+		Second.Init(7, 1024);
+		{
+			auto File = MakeShared<FSERecordSpillFile, ESPMode::ThreadSafe>();
+			const int64 FirstOffset = File->Append(CopyTemp(First));
+			const int64 SecondOffset = File->Append(CopyTemp(Second));
+			TestEqual("First offset", FirstOffset, int64(0));
+			TestEqual("Second offset", SecondOffset, int64(First.Num()));
+
+			// Bytes can be read while they are written
+			TArray<uint8> Bytes;
+			TestTrue("Read before written", File->Read(SecondOffset, Second.Num(), Bytes) && Bytes == Second);
+
+			for (int32 I = 0; I < 1000 && File->HasPendingWrites(); ++I)
+			{
+				FPlatformProcess::Sleep(0.001f);
+			}
+			TestFalse("Written", File->HasPendingWrites());
+
+			TestTrue("First read from disk", File->Read(FirstOffset, First.Num(), Bytes) && Bytes == First);
+			TestTrue("Second read from disk", File->Read(SecondOffset, Second.Num(), Bytes) && Bytes == Second);
+			TestFalse("Read past the end", File->Read(SecondOffset, Second.Num() + 1, Bytes));
+
+			// Freed space is reused
+			File->Free(FirstOffset, First.Num());
+			const int64 ReusedOffset = File->Append(TArray<uint8>{ 4, 5 });
+			TestEqual("Freed space reused", ReusedOffset, FirstOffset);
+			TestTrue("Reused bytes read", File->Read(ReusedOffset, 2, Bytes) && Bytes == TArray<uint8>{ 4, 5 });
+			TestEqual("Bigger bytes appended at the end", File->Append(CopyTemp(First)), int64(First.Num() + Second.Num()));
+
+			for (int32 I = 0; I < 1000 && File->HasPendingWrites(); ++I)
+			{
+				FPlatformProcess::Sleep(0.001f);
+			}
+			File->Free(SecondOffset, Second.Num());
+			File->Free(SecondOffset + Second.Num(), First.Num());
+			TestEqual("Space at the end released", File->GetSize(), int64(2));
+		}
+
+		// Background writes release the file right after writing
+		TArray<FString> Files;
+		for (int32 I = 0; I < 1000; ++I)
+		{
+			Files.Reset();
+			IFileManager::Get().FindFiles(Files, *(FSERecordSpillFile::GetDirectory() / TEXT("Records-*.tmp")), true, false);
+			if (Files.Num() <= 0)
+			{
+				break;
+			}
+			FPlatformProcess::Sleep(0.001f);
+		}
+		TestEqual("Deleted once released", Files.Num(), 0);
+	});
+
 	AfterEach([this]() {
+		// Tests can change the cache budget
+		FFileAdapter::SetFileCacheBudget(int64(GetDefault<USaveSettings>()->FileCacheSizeMB) * 1024 * 1024);
+		GetMutableDefault<USaveSettings>()->ThumbnailCacheSize = ThumbnailCacheSize;
+
 		if (SaveManager)
 		{
 			bFinishTick = false;
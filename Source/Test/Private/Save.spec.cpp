@@ -4,6 +4,8 @@
 #include "Helpers/TestActor.h"
 #include "SaveManager.h"
 
+#include <Engine/LevelStreamingDynamic.h>
+
 
 class FSaveSpec_Preset : public Automatron::FTestSpec
 {
@@ -73,6 +75,152 @@ void FSaveSpec_Preset::Define()
 			TestTrue("Loaded", SaveManager->LoadSlot(0));
 		});
 
+		It("Fails to load a slot that doesn't exist", [this]() {
+			TestPreset->MultithreadedSerialization = ESaveASyncMode::OnlySync;
+			TestPreset->MultithreadedFiles = ESaveASyncMode::LoadAsync;
+
+			bool bFailed = false;
+			TestTrue("Started loading", SaveManager->LoadSlot(FName{ TEXT("Missing") }, FOnGameLoaded::CreateLambda([&bFailed](USlotInfo* Info) {
+				bFailed = Info == nullptr;
+			})));
+			TickUntilSaveTasksFinish();
+			TestTrue("Load failed", bFailed);
+		});
+
+		It("Can load into the current data", [this]() {
+			TestPreset->MultithreadedSerialization = ESaveASyncMode::OnlySync;
+			TestPreset->bReuseSlotData = true;
+
+			TestActor->MyU8 = 34;
+			TestTrue("Saved", SaveManager->SaveSlot(0));
+			const USlotData* Data = SaveManager->GetCurrentData();
+
+			TestActor->MyU8 = 212;
+			TestTrue("Loading", SaveManager->LoadSlot(0));
+			TickUntilSaveTasksFinish();
+			TestEqual("uint8 was restored", TestActor->MyU8, 34);
+			TestTrue("Data was reused", SaveManager->GetCurrentData() == Data);
+		});
+
+		It("Keeps reused records if a load fails", [this]() {
+			TestPreset->MultithreadedSerialization = ESaveASyncMode::OnlySync;
+			TestPreset->MultithreadedFiles = ESaveASyncMode::LoadAsync;
+			TestPreset->bReuseSlotData = true;
+			TestPreset->bPreloadReferences = false;
+
+			TestTrue("Saved", SaveManager->SaveSlot(0));
+			TestTrue("Loading", SaveManager->LoadSlot(0));
+			TickUntilSaveTasksFinish();
+			const int32 NumRecords = SaveManager->GetCurrentData()->MainLevel.Actors.Num();
+			TestTrue("Records were kept", NumRecords > 0);
+
+			TestTrue("Loading missing slot", SaveManager->LoadSlot(FName{ TEXT("Missing") }));
+			TickUntilSaveTasksFinish();
+			TestEqual("Records are still valid", SaveManager->GetCurrentData()->MainLevel.Actors.Num(), NumRecords);
+		});
+
+		It("Can stream records while saving", [this]() {
+			TestPreset->MultithreadedSerialization = ESaveASyncMode::OnlySync;
+			TestPreset->bStreamRecords = true;
+
+			TestActor->MyU8 = 34;
+			TestTrue("Saved", SaveManager->SaveSlot(0));
+
+			TestActor->MyU8 = 212;
+			TestTrue("Loading", SaveManager->LoadSlot(0));
+			TickUntilSaveTasksFinish();
+			TestEqual("uint8 was restored", TestActor->MyU8, 34);
+		});
+
+		It("Can restore an actor from a snapshot", [this]() {
+			TestPreset->MultithreadedSerialization = ESaveASyncMode::OnlySync;
+
+			TestActor->MyU8 = 34;
+			TestTrue("Captured", SaveManager->CaptureSnapshot());
+			TestEqual("Snapshots", SaveManager->GetNumSnapshots(), 1);
+
+			TestActor->MyU8 = 212;
+			TestTrue("Restored", SaveManager->RestoreSnapshot());
+			TickUntilSaveTasksFinish();
+			TestEqual("uint8 was restored", TestActor->MyU8, 34);
+		});
+
+		It("Merges saves to the same slot waiting to start", [this]() {
+			TestPreset->MultithreadedSerialization = ESaveASyncMode::OnlySync;
+			TestPreset->MultithreadedFiles = ESaveASyncMode::SaveAsync;
+
+			int32 NumSaved = 0;
+			const FOnGameSaved OnSaved = FOnGameSaved::CreateLambda([&NumSaved](USlotInfo* Info) {
+				NumSaved += Info != nullptr;
+			});
+
+			TestTrue("Saving", SaveManager->SaveSlot(0, true, false, {}, OnSaved));
+			TestTrue("Waiting", SaveManager->SaveSlot(0, true, false, {}, OnSaved));
+			TestTrue("Merged", SaveManager->SaveSlot(0, true, false, {}, OnSaved));
+			TickUntilSaveTasksFinish();
+
+			TestEqual("All saves notified", NumSaved, 3);
+		});
+
+		It("Can cancel saves waiting to start", [this]() {
+			TestPreset->MultithreadedSerialization = ESaveASyncMode::OnlySync;
+			TestPreset->MultithreadedFiles = ESaveASyncMode::SaveAsync;
+
+			bool bCancelNotified = false;
+			TestTrue("Saving", SaveManager->SaveSlot(0));
+			TestTrue("Waiting", SaveManager->SaveSlot(0, true, false, {}, FOnGameSaved::CreateLambda([&bCancelNotified](USlotInfo* Info) {
+				bCancelNotified = Info == nullptr;
+			})));
+
+			TestEqual("Cancelled", SaveManager->CancelPendingSaves(), 1);
+			TestTrue("Cancel was notified", bCancelNotified);
+			TickUntilSaveTasksFinish();
+		});
+
+		It("Streams levels in once a multithreaded save wrote its file", [this]() {
+			TestPreset->MultithreadedSerialization = ESaveASyncMode::SaveAsync;
+			TestPreset->MultithreadedFiles = ESaveASyncMode::SaveAsync;
+
+			ULevelStreamingDynamic* Level = NewObject<ULevelStreamingDynamic>(GetMainWorld());
+			Level->SetWorldAssetByPackageName(FName{ TEXT("/Game/StreamedLevel") });
+
+			TestTrue("Saving", SaveManager->SaveSlot(0));
+			TestTrue("Writing file", SaveManager->HasTasks());
+
+			// Same call level streaming notifiers do when a level is shown
+			SaveManager->ProcessEvent(SaveManager->FindFunctionChecked(TEXT("DeserializeStreamingLevel")), &Level);
+			TestEqual("Level waits for the file", SaveManager->GetNumWaitingTasks(), 1);
+
+			TickUntilSaveTasksFinish();
+			TestFalse("No tasks left", SaveManager->HasTasks());
+		});
+
+		It("Can save synchronously in an emergency", [this]() {
+			TestPreset->MultithreadedFiles = ESaveASyncMode::SaveAsync;
+
+			TestActor->MyU8 = 34;
+			TestTrue("Saved", SaveManager->EmergencySave(FName{ TEXT("0") }) != EEmergencySaveResult::Failed);
+			TestFalse("No tasks left", SaveManager->HasTasks());
+
+			TestActor->MyU8 = 212;
+			SaveManager->LoadSlot(0);
+			TickUntilSaveTasksFinish();
+			TestEqual("uint8 was saved", TestActor->MyU8, 34);
+		});
+
+		It("Finishes running saves before an emergency save", [this]() {
+			TestPreset->MultithreadedSerialization = ESaveASyncMode::OnlySync;
+			TestPreset->MultithreadedFiles = ESaveASyncMode::SaveAsync;
+
+			TestTrue("Saving", SaveManager->SaveSlot(1));
+			TestTrue("Writing file", SaveManager->HasTasks());
+
+			TestActor->MyU8 = 34;
+			TestTrue("Saved", SaveManager->EmergencySave(FName{ TEXT("0") }) != EEmergencySaveResult::Failed);
+			TestFalse("No tasks left", SaveManager->HasTasks());
+			TestTrue("Previous save was written", FFileAdapter::DoesFileExist(TEXT("1")));
+		});
+
 		xIt("Can save an actor asynchronously", [this]() {
 			TestNotImplemented();
 		});
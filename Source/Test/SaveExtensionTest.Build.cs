@@ -17,7 +17,8 @@ namespace UnrealBuildTool.Rules
 				"Engine",
 				"CoreUObject",
 				"SaveExtension",
-				"EngineSettings"
+				"EngineSettings",
+				"ImageWrapper"
 			});
 
             if (Target.bBuildEditor == true)